@@ -8,20 +8,36 @@
 #define BIGINTERGER_VERSION (3.0)
 
 #include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <climits>
 #include <cmath>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <random>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 class ZeroDivisionError : public std::exception {
 public:
 	const char* what() const throw() {return "Division is zero";}
 };
-class FFTLimitExceededError : public std::exception {
+class FFTLimitExceededError : public std::exception {  // A transform above 2^21 points, reachable only without __int128 (so without the NTT)
 public:
 	const char* what() const throw() {return "FFT limit exceeded";}
 };
@@ -29,46 +45,223 @@ class NegativeRadicandError : public std::exception {
 public:
 	const char* what() const throw() {return "Radicand is negative";}
 };
+class NegativeUnsignedError : public std::exception {
+public:
+	const char* what() const throw() {return "Negative value as unsigned bytes";}
+};
+class NegativeExponentError : public std::exception {
+public:
+	const char* what() const throw() {return "Exponent is negative";}
+};
+class NotInvertibleError : public std::exception {
+public:
+	const char* what() const throw() {return "Value is not invertible";}
+};
+class InvalidFormatError : public std::exception {
+public:
+	const char* what() const throw() {return "Invalid binary format";}
+};
 
 // The constants
 using digit_t = int64_t;
 constexpr int WIDTH = 8;
 constexpr digit_t BASE = 1e8;
-constexpr int FFT_LIMIT = 8;
+constexpr int INLINE_LIMBS = 4;  // Values up to BASE^INLINE_LIMBS are stored without heap allocation
+constexpr int KARATSUBA_LIMIT = 96;  // The length of the shorter operand from which each algorithm is used
+constexpr int TOOM3_LIMIT = 192;
+constexpr int FFT_LIMIT = 224;
+constexpr int UNBALANCED_FFT_LIMIT = 96;  // The same for FFT when the longer operand is at least 4 times as long
+constexpr int NTT_LIMIT = 1 << 17;  // The total length (n + m) from which the exact NTT is used
+constexpr int PARALLEL_LIMIT = 1 << 14;  // The default total length from which work is split across threads
+constexpr int RADIX_LIMIT = 64;  // The length from which radix conversion divides and conquers
+constexpr int BINARY_NTT_LIMIT = 512;  // The length of the shorter operand from which 2^32 limbs are multiplied by NTT
 constexpr int NEWTON_DIV_MIN_LEVEL = 8;
-constexpr int NEWTON_DIV_LIMIT = 32;
-constexpr int NEWTON_SQRT_LIMIT = 48;
-constexpr int NEWTON_SQRT_MIN_LEVEL = 6;
+constexpr int BZ_DIV_LIMIT = 48;  // The length of the divisor from which Burnikel-Ziegler division is used
+constexpr int NEWTON_DIV_LIMIT = 512;  // The length of the divisor and the quotient from which Newton division is used
+constexpr int SQRT_LIMIT = 48;  // The length from which the square root is found by Karatsuba square root
+constexpr int HENSEL_DIV_LIMIT = 128;  // The length of the quotient (and twice the divisor) from which exact division uses Newton's inverse modulo BASE^n
+constexpr int HGCD_LIMIT = 128;  // The length from which GCD steps are taken by half-GCD instead of Lehmer
+static_assert(KARATSUBA_LIMIT >= 2 && KARATSUBA_LIMIT < 512);
+static_assert(KARATSUBA_LIMIT <= TOOM3_LIMIT);
+static_assert(BZ_DIV_LIMIT >= 3);
 static_assert(NEWTON_DIV_MIN_LEVEL < NEWTON_DIV_LIMIT);
-static_assert(NEWTON_SQRT_MIN_LEVEL < NEWTON_SQRT_LIMIT);
+static_assert(SQRT_LIMIT >= 4);
+
+#ifdef __SIZEOF_INT128__
+using uword_t = unsigned __int128;  // The magnitude of any machine integer operand
+#else
+using uword_t = uint64_t;
+#endif  // __SIZEOF_INT128__
+template <typename T> struct is_word : std::integral_constant<bool, std::is_integral<T>::value && !std::is_same<T, bool>::value> {};
+#ifdef __SIZEOF_INT128__
+template <> struct is_word<__int128> : std::true_type {};  // Not integral in strict modes
+template <> struct is_word<unsigned __int128> : std::true_type {};
+#endif  // __SIZEOF_INT128__
+
+template <typename T, int N> class small_vector {  // A vector of trivially copyable T keeping up to N elements inline
+	T* ptr;
+	uint32_t len, cap;
+	T buf[N];
+	
+	bool is_inline() const {return ptr == buf;}
+#ifdef BIGINTEGER_COW
+	// A heap buffer is prefixed with a reference count and shared by copies; every write goes through detach(), which
+	// copies a shared buffer first, so a buffer seen by several vectors is never written
+	struct alignas(T) header {std::atomic<uint32_t> refs;};
+	std::atomic<uint32_t>& refs() const {return (reinterpret_cast<header*>(ptr) - 1)->refs;}
+	static T* allocate(size_t c) {
+		header* h = new (::operator new(sizeof(header) + c * sizeof(T))) header;
+		return h->refs.store(1, std::memory_order_relaxed), reinterpret_cast<T*>(h + 1);
+	}
+	__attribute__((noinline)) void unref() {if (refs().fetch_sub(1, std::memory_order_acq_rel) == 1) ::operator delete(reinterpret_cast<header*>(ptr) - 1);}
+	void release() {if (!is_inline()) unref();}
+	bool shared() const {return !is_inline() && refs().load(std::memory_order_acquire) != 1;}
+	__attribute__((noinline, cold)) void copy_shared() {
+		T* p = allocate(cap);
+		std::copy(ptr, ptr + len, p), release(), ptr = p;
+	}
+	void detach() {if (shared()) copy_shared();}
+	void drop_shared() {if (shared()) release(), ptr = buf, cap = N;}  // Before the elements are overwritten as a whole
+#else
+	static T* allocate(size_t c) {return new T[c];}
+	void release() {if (!is_inline()) delete[] ptr;}
+	void detach() {}
+	void drop_shared() {}
+#endif  // BIGINTEGER_COW
+	void grow(size_t n) {  // Move to the heap with room for at least n elements
+		size_t c = std::max(n, (size_t) cap << 1);
+		T* p = allocate(c);
+		std::copy(ptr, ptr + len, p);
+		release();
+		ptr = p, cap = c;
+	}
+public:
+	small_vector() : ptr(buf), len(0), cap(N) {}
+	explicit small_vector(size_t n, const T& x = T()) : small_vector() {resize(n, x);}
+	small_vector(const T* first, const T* last) : small_vector() {assign(first, last);}
+	small_vector(const small_vector& x) : small_vector() {*this = x;}
+	small_vector(small_vector&& x) noexcept : small_vector() {*this = std::move(x);}
+	~small_vector() {release();}
+	
+	small_vector& operator= (const small_vector& x) {
+		if (this == &x) return *this;
+#ifdef BIGINTEGER_COW
+		if (!x.is_inline()) {  // Share the heap buffer of x
+			x.refs().fetch_add(1, std::memory_order_relaxed), release();
+			return ptr = x.ptr, len = x.len, cap = x.cap, *this;
+		}
+#endif  // BIGINTEGER_COW
+		return assign(x.begin(), x.end()), *this;
+	}
+	small_vector& operator= (small_vector&& x) noexcept {  // Steals a heap buffer, copies inline elements
+		if (this == &x) return *this;
+		if (x.is_inline()) return drop_shared(), std::copy(x.buf, x.buf + x.len, ptr), len = x.len, x.len = 0, *this;
+		release();
+		ptr = x.ptr, len = x.len, cap = x.cap;
+		x.ptr = x.buf, x.len = 0, x.cap = N;
+		return *this;
+	}
+	void assign(const T* first, const T* last) {
+		drop_shared(), len = 0, reserve(last - first);
+		std::copy(first, last, ptr), len = last - first;
+	}
+	
+	size_t size() const {return len;}
+	bool empty() const {return len == 0;}
+	T* data() {return detach(), ptr;}
+	const T* data() const {return ptr;}
+	T* begin() {return detach(), ptr;}
+	const T* begin() const {return ptr;}
+	T* end() {return detach(), ptr + len;}
+	const T* end() const {return ptr + len;}
+	T& operator[] (size_t i) {return detach(), ptr[i];}
+	const T& operator[] (size_t i) const {return ptr[i];}
+	T& back() {return detach(), ptr[len - 1];}
+	const T& back() const {return ptr[len - 1];}
+	
+	void reserve(size_t n) {if (n > cap) grow(n);}
+	void resize(size_t n, const T& x = T()) {
+		reserve(n);
+		if (n > len) detach(), std::fill(ptr + len, ptr + n, x);
+		len = n;
+	}
+	void clear() {len = 0;}
+	void emplace_back(T x) {
+		if (len == cap) grow(len + 1);
+		else detach();
+		ptr[len++] = x;
+	}
+	void pop_back() {len--;}
+};
+using limb_vector = small_vector<digit_t, INLINE_LIMBS>;
 
 struct BigInteger {
 protected:
-	std::vector<digit_t> digits;
+	limb_vector digits;
 	bool flag;
-	BigInteger(const std::vector<digit_t>& v) 
-	: digits(v.begin(), v.end()), flag(true) {trim();}
+	BigInteger(limb_vector&& v) : digits(std::move(v)), flag(true) {trim();}
 	
 	BigInteger& trim() {  // Remove the leading zeros
-		while (digits.size() > 1U && digits.back() == 0) digits.pop_back();
+		const limb_vector& d = digits;  // Reads only, so a shared buffer is not copied
+		while (d.size() > 1U && d.back() == 0) digits.pop_back();
 		return *this;
 	}
 	digit_t operator[] (int x) const {return x < (int) digits.size() ? digits[x] : 0;}
 
-	BigInteger& build_binary(const std::vector<bool>&);
+	friend struct BinaryInteger;
+	template <int> friend struct FixedBigInteger;
+	friend struct Modulus;
+	friend struct Divisor;
+	friend struct Multiplicand;
+	friend struct Accumulator;
+	friend struct BigIntegerView;
 	
+	static BigInteger mul_abs(const BigInteger&, const BigInteger&);
+	static BigInteger sqr_abs(const BigInteger&);
 	static BigInteger fft_mul(const BigInteger&, const BigInteger&);
+	static BigInteger fft_mul_unbalanced(const BigInteger&, const BigInteger&, int = 0, const double* = nullptr);
+	static BigInteger ntt_mul(const BigInteger&, const BigInteger&);
+	static int cyclic_length(int);
+	static BigInteger fold(const BigInteger&, int);
+	static BigInteger balance(BigInteger, int);
+	static BigInteger mul_cyclic(const BigInteger&, const BigInteger&, int);
 	BigInteger newton_inv(int n) const;
+	BigInteger hensel_inv(int n) const;
+	BigInteger low(int n) const {return limb_vector(digits.begin(), digits.begin() + std::min(n, (int) digits.size()));}
+	BigInteger& add_mag(const digit_t*, int, bool);
+	void add_mul(const BigInteger&, const BigInteger&, bool);
+	template <typename T> using if_word = typename std::enable_if<is_word<T>::value, int>::type;
+	template <typename T> static uword_t magnitude(T x) {return x < T(0) ? uword_t(0) - uword_t(x) : uword_t(x);}
+	static int split(uword_t, digit_t*);
+	BigInteger& set_word(uword_t, bool);
+	BigInteger& mul_word(uword_t, bool);
+	uword_t div_word(uword_t);
+	uword_t mod_word(uword_t) const;
+	BigInteger& set_chars(const char*, size_t, bool);
+	template <typename Source> bool scan_digits(Source&);
+	static std::pair<BigInteger, BigInteger> div_basecase(const BigInteger&, const BigInteger&);
+	static std::pair<BigInteger, BigInteger> div_bz(const BigInteger&, const BigInteger&);
+	static std::pair<BigInteger, BigInteger> div2n1n(const BigInteger&, const BigInteger&, int);
+	static std::pair<BigInteger, BigInteger> div3n2n(const BigInteger&, const BigInteger&, const BigInteger&, 
+		const BigInteger&, const BigInteger&, int);
 	BigInteger sqrt_normal() const;
-	BigInteger newton_invsqrt() const;
+	static std::pair<BigInteger, BigInteger> sqrtrem(const BigInteger&);
+	struct matrix;
+	static void combine(BigInteger&, BigInteger&, digit_t, digit_t, digit_t, digit_t);
+	static bool lehmer(BigInteger&, BigInteger&, matrix*);
+	static void euclid(BigInteger&, BigInteger&, matrix*);
+	static void hgcd(BigInteger&, BigInteger&, int, matrix*);
+	static BigInteger gcd_abs(BigInteger, BigInteger, matrix*);
 public:
 	BigInteger() : flag(true) {digits.emplace_back(0);}
-	BigInteger(const BigInteger& x) {*this = x;}
+	BigInteger(const BigInteger& x) : digits(x.digits), flag(x.flag) {}
+	BigInteger(BigInteger&& x) noexcept : digits(std::move(x.digits)), flag(x.flag) {x.digits.emplace_back(0), x.flag = true;}  // x is left as 0
 	BigInteger(const int64_t& x) {*this = x;}
 	BigInteger(const std::string& s) {*this = s;}
 	BigInteger(const std::vector<bool>& v) {*this = v;}
 	
 	BigInteger& operator= (const BigInteger&);
+	BigInteger& operator= (BigInteger&&) noexcept;
 	BigInteger& operator= (const int64_t&);
 	BigInteger& operator= (const std::string&);
 	BigInteger& operator= (const std::vector<bool>&);
@@ -76,23 +269,33 @@ public:
 	std::string to_string() const;
 	int64_t to_int64() const;
 	std::vector<bool> to_binary() const;
+	std::vector<uint8_t> to_bytes(bool big_endian = true, bool is_signed = false) const;
+	static BigInteger from_bytes(const uint8_t*, size_t, bool big_endian = true, bool is_signed = false);
+	static BigInteger from_bytes(const std::vector<uint8_t>& v, bool big_endian = true, bool is_signed = false) {
+		return from_bytes(v.data(), v.size(), big_endian, is_signed);
+	}
+	std::string to_hex() const;
+	static BigInteger from_hex(const std::string&);
 #ifdef __SIZEOF_INT128__
 	BigInteger& from_int128(const __int128&);
 	__int128 to_int128() const;
 #endif  // __SIZEOF_INT128__
 	
-	// I/O operations
-	friend std::ostream& operator<< (std::ostream& out, const BigInteger& x) {
-		if (!x.flag) out << '-';
-		out << x.digits.back();
-		int n = x.digits.size();
-		for (int i = n - 2; i >= 0; i--) out << std::setw(WIDTH) << std::setfill('0') << x.digits[i];
-		return out;
-	}
-	friend std::istream& operator>> (std::istream& in, BigInteger& x) {
-		std::string s; 
-		return in >> s, x = s, in;
-	}
+	// I/O operations, 8 digits at a time straight between the limbs and the characters
+	friend std::ostream& operator<< (std::ostream&, const BigInteger&);
+	friend std::istream& operator>> (std::istream&, BigInteger&);
+	friend std::to_chars_result to_chars(char*, char*, const BigInteger&);
+	friend std::from_chars_result from_chars(const char*, const char*, BigInteger&);
+	size_t to_chars_length() const;
+	bool scan(FILE*);
+	void print(FILE*) const;
+	
+	// The versioned binary format of one value or an array, which BigIntegerView and ArchiveView read in place
+	void save(std::ostream&) const;
+	static void save(std::ostream&, const BigInteger*, size_t);
+	static void save(std::ostream& out, const std::vector<BigInteger>& v) {save(out, v.data(), v.size());}
+	static BigInteger load(std::istream&);
+	static std::vector<BigInteger> load_all(std::istream&);
 	
 	bool zero() const {return digits.size() == 1 && digits[0] == 0;}
 	bool operator! () const {return digits.size() != 1 || digits[0] != 0;}
@@ -115,47 +318,94 @@ public:
 	bool operator>= (const BigInteger&) const;
 #endif   // __cplusplus >= 202002L
 	
-	BigInteger operator- () const;
-	BigInteger operator~ () const;
-	BigInteger abs() const;
+	// The overloads on temporaries reuse their storage for the result
+	BigInteger operator- () const &;
+	BigInteger operator- () &&;
+	BigInteger operator~ () const &;
+	BigInteger operator~ () &&;
+	BigInteger abs() const &;
+	BigInteger abs() &&;
 	
-	BigInteger& operator+= (const int32_t&);
-	BigInteger operator+ (const int32_t&) const;
+	// Machine integers of any width up to __int128 are split into at most 5 limbs, each operation is one pass
+	template <typename T, if_word<T> = 0> BigInteger& operator+= (T x) {digit_t y[5]; return add_mag(y, split(magnitude(x), y), x < T(0));}
+	template <typename T, if_word<T> = 0> BigInteger operator+ (T x) const & {return BigInteger(*this) += x;}
+	template <typename T, if_word<T> = 0> BigInteger operator+ (T x) && {return std::move(*this += x);}
 	BigInteger& operator+= (const BigInteger&);
-	BigInteger operator+ (const BigInteger&) const;
+	BigInteger operator+ (const BigInteger&) const &;
+	BigInteger operator+ (const BigInteger&) &&;
+	BigInteger operator+ (BigInteger&&) const &;
+	BigInteger operator+ (BigInteger&&) &&;
 	BigInteger& operator++ ();
 	BigInteger operator++ (int);
 	
-	BigInteger& operator-= (const int32_t&);
-	BigInteger operator- (const int32_t&) const;
+	template <typename T, if_word<T> = 0> BigInteger& operator-= (T x) {digit_t y[5]; return add_mag(y, split(magnitude(x), y), x > T(0));}
+	template <typename T, if_word<T> = 0> BigInteger operator- (T x) const & {return BigInteger(*this) -= x;}
+	template <typename T, if_word<T> = 0> BigInteger operator- (T x) && {return std::move(*this -= x);}
 	BigInteger& operator-= (const BigInteger&);
-	BigInteger operator- (const BigInteger&) const;
+	BigInteger operator- (const BigInteger&) const &;
+	BigInteger operator- (const BigInteger&) &&;
+	BigInteger operator- (BigInteger&&) const &;
+	BigInteger operator- (BigInteger&&) &&;
 	BigInteger& operator-- ();
 	BigInteger operator-- (int);
 	
 	BigInteger& operator*= (const BigInteger&);
-	BigInteger operator* (const BigInteger&) const;
+	BigInteger operator* (const BigInteger&) const &;
+	BigInteger operator* (const BigInteger&) &&;
+	BigInteger operator* (BigInteger&&) const &;
+	BigInteger operator* (BigInteger&&) &&;
 	BigInteger square() const;
-	BigInteger& operator*= (int32_t);
-	BigInteger operator* (const int32_t&) const;
+	template <typename T, if_word<T> = 0> BigInteger& operator*= (T x) {return mul_word(magnitude(x), x < T(0));}
+	template <typename T, if_word<T> = 0> BigInteger operator* (T x) const & {return BigInteger(*this) *= x;}
+	template <typename T, if_word<T> = 0> BigInteger operator* (T x) && {return std::move(*this *= x);}
+	
+	// Fused and in-place forms, which work in the storage of acc and dst instead of temporaries
+	friend void mul(BigInteger&, const BigInteger&, const BigInteger&);  // dst = a * b
+	friend void addmul(BigInteger&, const BigInteger&, const BigInteger&);  // acc += a * b
+	friend void submul(BigInteger&, const BigInteger&, const BigInteger&);  // acc -= a * b
+	friend void addmul_ui(BigInteger&, const BigInteger&, uint64_t);  // acc += a * x
+	friend void submul_ui(BigInteger&, const BigInteger&, uint64_t);  // acc -= a * x
 	
 	BigInteger half() const;
-	BigInteger& operator/= (int64_t);
-	BigInteger operator/ (const int64_t&) const;
+	template <typename T, if_word<T> = 0> BigInteger& operator/= (T x) {
+		div_word(magnitude(x)), flag = zero() || flag != (x < T(0));
+		return *this;
+	}
+	template <typename T, if_word<T> = 0> BigInteger operator/ (T x) const & {return BigInteger(*this) /= x;}
+	template <typename T, if_word<T> = 0> BigInteger operator/ (T x) && {return std::move(*this /= x);}
+	template <typename T, if_word<T> = 0> BigInteger& operator%= (T x) {return set_word(mod_word(magnitude(x)), negative());}
+	template <typename T, if_word<T> = 0> BigInteger operator% (T x) const & {
+		BigInteger r;
+		r.set_word(mod_word(magnitude(x)), negative());
+		return r;
+	}
+	template <typename T, if_word<T> = 0> BigInteger operator% (T x) && {return std::move(*this %= x);}
+	template <typename T, if_word<T> = 0> std::pair<BigInteger, BigInteger> divmod(T x) const {
+		BigInteger q = *this, r;
+		r.set_word(q.div_word(magnitude(x)), negative()), q.flag = q.zero() || flag != (x < T(0));
+		return std::make_pair(std::move(q), std::move(r));
+	}
+	uint64_t mod_ui(uint64_t) const;
 	std::pair<BigInteger, BigInteger> divmod(const BigInteger&) const;
-	BigInteger operator/ (const BigInteger&) const;
+	BigInteger divexact(const BigInteger&) const;
+	BigInteger operator/ (const BigInteger&) const &;
+	BigInteger operator/ (const BigInteger&) &&;
 	BigInteger& operator/= (const BigInteger&);
-	BigInteger operator% (const BigInteger&) const;
+	BigInteger operator% (const BigInteger&) const &;
+	BigInteger operator% (const BigInteger&) &&;
 	BigInteger& operator%= (const BigInteger&);
 	bool mod2() const {return digits[0] & 1;}
 	
 	BigInteger pow(int64_t) const;
 	BigInteger pow(int64_t, const BigInteger&) const;
+	BigInteger pow(const BigInteger&, const BigInteger&) const;
 	
 	BigInteger sqrt() const;
 	BigInteger root(const int64_t&) const;
 	
-	BigInteger gcd(BigInteger) const;
+	BigInteger gcd(const BigInteger&) const;
+	std::tuple<BigInteger, BigInteger, BigInteger> gcdext(const BigInteger&) const;
+	BigInteger modinv(const BigInteger&) const;
 	BigInteger lcm(const BigInteger&) const;
 	
 	BigInteger operator<< (const int64_t&) const;
@@ -171,93 +421,222 @@ public:
 	BigInteger& operator^= (const BigInteger&);
 };
 
+namespace __IO {  // Decimal text kernels, one limb of 8 digits at a time
+	struct digit_pairs {
+		char c[200];
+		constexpr digit_pairs() : c() {for (int i = 0; i < 100; i++) c[i << 1] = '0' + i / 10, c[i << 1 | 1] = '0' + i % 10;}
+	};
+	constexpr digit_pairs PAIRS;
+	inline void format8(digit_t v, char* p) {  // The 8 digits of v < BASE with leading zeros into p[0, 8)
+		int hi = v / 10000, lo = v % 10000;
+		std::memcpy(p, PAIRS.c + 2 * (hi / 100), 2), std::memcpy(p + 2, PAIRS.c + 2 * (hi % 100), 2);
+		std::memcpy(p + 4, PAIRS.c + 2 * (lo / 100), 2), std::memcpy(p + 6, PAIRS.c + 2 * (lo % 100), 2);
+	}
+	inline digit_t parse8(const char* p) {  // The value of the 8 digits p[0, 8)
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		uint64_t v;  // Adjacent digits, then pairs, then quads are joined in the lanes of one word
+		std::memcpy(&v, p, 8);
+		v = (v & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+		v = (v & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+		return (v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32;
+#else
+		digit_t v = 0;
+		for (int i = 0; i < 8; i++) v = v * 10 + p[i] - '0';
+		return v;
+#endif
+	}
+	inline int length(digit_t v) {  // The number of digits of v, at least 1
+		int k = 1;
+		while (v >= 10) v /= 10, k++;
+		return k;
+	}
+	inline size_t chars_length(const digit_t* d, int n, bool neg) {  // The text of the n limbs d with the sign
+		return (size_t) (n - 1) * WIDTH + length(d[n - 1]) + neg;
+	}
+	inline std::to_chars_result to_chars(char* first, char* last, const digit_t* d, int n, bool neg) {
+		size_t len = chars_length(d, n, neg);
+		if ((size_t) (last - first) < len) return {last, std::errc::value_too_large};
+		char* p = first + len;
+		for (int i = 0; i < n - 1; i++) p -= WIDTH, format8(d[i], p);
+		for (digit_t v = d[n - 1]; p > first + neg; v /= 10) *--p = '0' + v % 10;
+		if (neg) *first = '-';
+		return {first + len, std::errc()};
+	}
+	template <typename Sink> void format(const digit_t* d, int n, bool neg, Sink sink) {  // To sink in blocks of up to 4 KiB
+		char buf[4096];
+		int len = neg, k = length(d[n - 1]);
+		buf[0] = '-';
+		for (digit_t v = d[n - 1], i = len + k - 1; i >= len; i--) buf[i] = '0' + v % 10, v /= 10;
+		len += k;
+		for (int i = n - 2; i >= 0; i--) {
+			if (len > (int) sizeof(buf) - WIDTH) sink(buf, len), len = 0;
+			format8(d[i], buf + len), len += WIDTH;
+		}
+		sink(buf, len);
+	}
+	
+	// The binary format is little-endian, the first word holds "BIGI" and the version
+	constexpr uint64_t HEADER = 0x49474942ULL | 1ULL << 32;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	constexpr bool HOST_LITTLE_ENDIAN = false;
+#else
+	constexpr bool HOST_LITTLE_ENDIAN = true;
+#endif
+	inline void store64(char* p, uint64_t x) {
+		if (HOST_LITTLE_ENDIAN) std::memcpy(p, &x, 8);
+		else for (int i = 0; i < 8; i++) p[i] = x >> (i << 3);
+	}
+	inline uint64_t load64(const char* p) {
+		uint64_t x = 0;
+		if (HOST_LITTLE_ENDIAN) std::memcpy(&x, p, 8);
+		else for (int i = 0; i < 8; i++) x |= (uint64_t) (uint8_t) p[i] << (i << 3);
+		return x;
+	}
+	struct stream_source {  // Characters of a streambuf, EOF at the end. next() takes one and looks at the one after
+		std::streambuf* buf;
+		int peek() {return buf->sgetc();}
+		int next() {return buf->snextc();}
+	};
+	struct file_source {  // Characters of a FILE, the one looked at but not taken is pushed back at the end
+		FILE* f;
+		int c;
+		file_source(FILE* f) : f(f), c(getc(f)) {}
+		~file_source() {if (c != EOF) ungetc(c, f);}
+		int peek() {return c;}
+		int next() {return c = getc(f);}
+	};
+}
+
 BigInteger& BigInteger::operator= (const BigInteger& x) {
-	flag = x.flag, digits = std::vector<digit_t>(x.digits.begin(), x.digits.end());
+	flag = x.flag, digits = x.digits;
 	return *this;
 }
-BigInteger& BigInteger::operator= (const int64_t& x) {
-	if (x == LLONG_MIN) return *this = "-9223372036854775808";
-	digits.clear(), flag = (x >= 0), digits.reserve(4);
-	if (x == 0) return digits.emplace_back(0), *this;
-	int64_t n = std::abs(x);
-	do {digits.emplace_back(n % BASE), n /= BASE;} while (n);
+BigInteger& BigInteger::operator= (BigInteger&& x) noexcept {
+	if (this == &x) return *this;
+	flag = x.flag, digits = std::move(x.digits);
+	x.digits.emplace_back(0), x.flag = true;
 	return *this;
 }
+BigInteger& BigInteger::operator= (const int64_t& x) {return set_word(magnitude(x), x < 0);}
 BigInteger& BigInteger::operator= (const std::string& s) {
-	digits.clear(), flag = true, digits.reserve(s.size() / WIDTH + 1);
-	if (s.empty() || s == "-") return *this = 0;
-	int n = s.size(), i = 0; 
-	while (i < n && s[i] == '-') flag ^= 1, i++;
-	for (int j = s.size() - 1; j >= i; j -= WIDTH) {
-		int start = std::max(i, j - WIDTH + 1), len = j - start + 1;
-		digits.emplace_back(std::stoll(s.substr(start, len)));
-	} 
-	return trim();
+	size_t i = 0, n = s.size();
+	bool neg = false;
+	while (i < n && s[i] == '-') neg ^= 1, i++;
+	for (size_t j = i; j < n; j++) if (s[j] < '0' || s[j] > '9') throw std::invalid_argument("Invalid decimal digit");
+	if (i == n) return *this = 0;
+	return set_chars(s.data() + i, n - i, neg);
 }
-BigInteger& BigInteger::build_binary(const std::vector<bool>& v) {
-	BigInteger k = 1;
-	for (int i = v.size() - 1; i >= 0; i--, k += k) {
-		if (v[i]) *this += k;
-	}
+std::string BigInteger::to_string() const {  // Convert to std::string
+	std::string res(to_chars_length(), '0');
+	to_chars(&res[0], &res[0] + res.size(), *this);
+	return res;
+}
+BigInteger& BigInteger::set_chars(const char* p, size_t n, bool neg) {  // From the decimal digits p[0, n), n > 0
+	size_t k = (n + WIDTH - 1) / WIDTH, r = n - (k - 1) * WIDTH;
+	digit_t top = 0;
+	for (size_t i = 0; i < r; i++) top = top * 10 + p[i] - '0';
+	digits.resize(k), digits[k - 1] = top;
+	for (size_t i = 0; i + 1 < k; i++) digits[i] = __IO::parse8(p + n - (i + 1) * WIDTH);
+	flag = !neg, trim(), flag |= zero();
 	return *this;
 }
-BigInteger& BigInteger::operator= (const std::vector<bool>& v) {
-	*this = 0;
-	if (v.empty()) return *this;
-	if (!v[0]) return build_binary(v);
-	int n = v.size();
-	std::vector<bool> b(n);
-	for (int i = 0; i < n; i++) b[i] = v[i] ^ 1;
-	build_binary(b);
-	return *this = ~(*this);
+// Leading '-' signs and decimal digits from src. Each 8 digits are packed into a limb in the order they come, and once
+// the length is known, the limbs are reversed and shifted by the s digits left over to line up with the low end
+template <typename Source> bool BigInteger::scan_digits(Source& src) {
+	bool neg = false;
+	char buf[WIDTH];
+	int s = 0, c;
+	for (c = src.peek(); c == '-'; c = src.next()) neg ^= 1;
+	digits.clear();
+	for (; c >= '0' && c <= '9'; c = src.next()) {
+		buf[s++] = c;
+		if (s == WIDTH) digits.emplace_back(__IO::parse8(buf)), s = 0;
+	}
+	if (digits.empty() && s == 0) return *this = 0, false;
+	digit_t low = 0, q = 1, m = digits.size();  // low is the part shifted in from below, q = 10^s
+	for (int i = 0; i < s; i++) low = low * 10 + buf[i] - '0', q *= 10;
+	std::reverse(digits.begin(), digits.end()), digits.emplace_back(0);
+	for (int i = 0; i < m; i++) {
+		digit_t g = digits[i];
+		digits[i] = g % (BASE / q) * q + low, low = g / (BASE / q);
+	}
+	digits[m] = low, flag = !neg, trim(), flag |= zero();
+	return true;
 }
-
-std::string BigInteger::to_string() const {  // Convert to std::string
-	std::stringstream stream;
-	return stream << *this, stream.str();
+size_t BigInteger::to_chars_length() const {  // The exact number of characters to_chars() writes
+	return __IO::chars_length(digits.data(), digits.size(), !flag);
+}
+std::to_chars_result to_chars(char* first, char* last, const BigInteger& x) {  // No terminating null, as std::to_chars
+	return __IO::to_chars(first, last, x.digits.data(), x.digits.size(), !x.flag);
+}
+std::from_chars_result from_chars(const char* first, const char* last, BigInteger& x) {  // x is kept when there are no digits
+	const char* p = first;
+	bool neg = false;
+	while (p < last && *p == '-') neg ^= 1, p++;
+	const char* q = p;
+	while (q < last && *q >= '0' && *q <= '9') q++;
+	if (q == p) return {first, std::errc::invalid_argument};
+	return x.set_chars(p, q - p, neg), std::from_chars_result{q, std::errc()};
+}
+std::ostream& operator<< (std::ostream& out, const BigInteger& x) {
+	__IO::format(x.digits.data(), x.digits.size(), !x.flag, [&](const char* p, int n) {out.write(p, n);});
+	return out;
+}
+std::istream& operator>> (std::istream& in, BigInteger& x) {  // Reads in place, the token is never held as a string
+	std::istream::sentry ok(in);
+	if (!ok) return in;
+	__IO::stream_source src{in.rdbuf()};
+	if (!x.scan_digits(src)) in.setstate(std::ios::failbit);
+	if (src.peek() == EOF) in.setstate(std::ios::eofbit);
+	return in;
+}
+bool BigInteger::scan(FILE* f) {  // As std::cin >> x, false when there is no number
+	int c;
+	while ((c = getc(f)) != EOF && std::isspace(c)) {}
+	if (c != EOF) ungetc(c, f);
+	__IO::file_source src(f);
+	return scan_digits(src);
+}
+void BigInteger::print(FILE* f) const {
+	__IO::format(digits.data(), digits.size(), !flag, [&](const char* p, int n) {fwrite(p, 1, n, f);});
 }
 int64_t BigInteger::to_int64() const {   // Convert to int64_t
-	int64_t res = 0;
+	uint64_t res = 0;  // Unsigned, so that INT64_MIN does not overflow
 	for (int i = digits.size() - 1; i >= 0; i--) res = res * BASE + digits[i];
-	return res;
-}
-std::vector<bool> BigInteger::to_binary() const {
-	if (zero()) return {0};
-	std::vector<bool> res;
-	if (flag) {
-		for (BigInteger x = *this; !x.zero(); x = x.half()) res.emplace_back(x.mod2());
-		res.emplace_back(0);
-	} else {
-		for (BigInteger x = ~(*this); !x.zero(); x = x.half()) res.emplace_back(x.mod2() ^ 1);
-		res.emplace_back(1);
-	}
-	std::reverse(res.begin(), res.end());
-	return res;
+	return flag ? (int64_t) res : (int64_t) (0 - res);
 }
-
 #ifdef __SIZEOF_INT128__
 // Support the operations of __int128
-BigInteger& BigInteger::from_int128(const __int128& x) {  // Build from __int128
-	digits.clear(), flag = (x >= 0), digits.reserve(8);
-	if (x == 0) return digits.emplace_back(0), *this;
-	__int128 n = (x < 0 ? -x : x);
-	do {digits.emplace_back(n % BASE), n /= BASE;} while (n);
-	return *this;
-}
+BigInteger& BigInteger::from_int128(const __int128& x) {return set_word(magnitude(x), x < 0);}  // Build from __int128
 __int128 BigInteger::to_int128() const {  // Convert to __int128
-	__int128 res = 0;
+	unsigned __int128 res = 0;  // Unsigned, so that -2^127 does not overflow
 	for (int i = digits.size() - 1; i >= 0; i--) res = res * BASE + digits[i];
-	return res;
+	return flag ? (__int128) res : (__int128) (0 - res);
 }
 #endif  // __SIZEOF_INT128__
+int BigInteger::split(uword_t x, digit_t* y) {  // The limbs of x into y[0, 5), returns their count (at least 1)
+	int k = 0;
+#ifdef __SIZEOF_INT128__
+	for (; x >> 64; x /= BASE) y[k++] = x % BASE;
+#endif  // __SIZEOF_INT128__
+	uint64_t v = x;
+	do y[k++] = v % BASE, v /= BASE; while (v);
+	return k;
+}
+BigInteger& BigInteger::set_word(uword_t x, bool neg) {  // this = (neg ? -x : x)
+	digit_t y[5];
+	digits.assign(y, y + split(x, y)), flag = !neg || x == 0;
+	return *this;
+}
 
 BigInteger BigInteger::_move_l(int x) const {
-	std::vector<digit_t> res(x, 0);
-	for (const digit_t& i : digits) res.emplace_back(i);
+	limb_vector res(x + digits.size());
+	std::copy(digits.begin(), digits.end(), res.begin() + x);
 	return res;
 }
 BigInteger BigInteger::_move_r(int x) const {
-	return std::vector<digit_t>(digits.begin() + x, digits.end());
+	if (x >= (int) digits.size()) return BigInteger();
+	return limb_vector(digits.begin() + x, digits.end());
 }
 
 int BigInteger::compare(const BigInteger& x) const {
@@ -283,457 +662,1277 @@ bool BigInteger::operator<= (const BigInteger& x) const {return compare(x) <= 0;
 bool BigInteger::operator>= (const BigInteger& x) const {return compare(x) >= 0;}
 #endif   // __cplusplus >= 202002L
 
-BigInteger BigInteger::operator- () const {
-	BigInteger res = *this;
-	return res.flag ^= 1, res;
-}
-BigInteger BigInteger::operator~ () const {return -(*this) - 1;}
-BigInteger BigInteger::abs() const {
-	BigInteger res = *this;
-	return res.flag = true, res;
-}
-
-BigInteger& BigInteger::operator+= (const int32_t& x) {
-	if (x == 0) return *this;
-	if (x < 0) return *this -= std::abs(x);
-	if (this->negative()) return *this = -(*this - x);
-	digits[0] += x;
-	if (digits[0] < BASE) return *this;
-	digits[0] -= BASE;
-	int i = 1;
-	while (true) {
-		if (i >= (int) digits.size()) digits.emplace_back(0);
-		if (++digits[i] < BASE) break;
-		digits[i] -= BASE, i++;
-	} 
-	return trim();
+BigInteger BigInteger::operator- () const & {return -BigInteger(*this);}
+BigInteger BigInteger::operator- () && {
+	flag ^= !zero();
+	return std::move(*this);
 }
-BigInteger BigInteger::operator+ (const int32_t& x) const {
-	return BigInteger(*this) += x;
+BigInteger BigInteger::operator~ () const & {return -(*this) - 1;}
+BigInteger BigInteger::operator~ () && {return -std::move(*this) - 1;}
+BigInteger BigInteger::abs() const & {return BigInteger(*this).abs();}
+BigInteger BigInteger::abs() && {
+	flag = true;
+	return std::move(*this);
 }
+
 BigInteger& BigInteger::operator+= (const BigInteger& x) {
-	if (x.negative()) return *this -= x.abs();
-	if (this->negative()) return *this = x - this->abs();
-	(flag ^= x.flag) ^= 1;
-	int n = std::max(digits.size(), x.digits.size()) + 1;
-	digit_t carry = 0;
-	for (int i = 0; i < n; i++) {
-		if (i >= (int) digits.size()) digits.emplace_back(0);
-		digits[i] += x[i] + carry;
-		if (digits[i] >= BASE) carry = 1, digits[i] -= BASE;
-		else carry = 0;
-	} 
-	return trim();
-}
-BigInteger BigInteger::operator+ (const BigInteger& x) const {
-	return BigInteger(*this) += x;
+	if (this == &x) return *this *= 2;
+	return add_mag(x.digits.data(), x.digits.size(), x.negative());
 }
+BigInteger BigInteger::operator+ (const BigInteger& x) const & {return BigInteger(*this) += x;}
+BigInteger BigInteger::operator+ (const BigInteger& x) && {return std::move(*this += x);}
+BigInteger BigInteger::operator+ (BigInteger&& x) const & {return std::move(x += *this);}
+BigInteger BigInteger::operator+ (BigInteger&& x) && {return std::move(*this += x);}
 BigInteger& BigInteger::operator++ () {return *this += 1;}
 BigInteger BigInteger::operator++ (int) {
 	BigInteger t = *this; 
 	return *this += 1, t;
 }
 
-BigInteger& BigInteger::operator-= (const int32_t& x) {
-	if (x == 0) return *this;
-	if (x < 0) return *this += std::abs(x);
-	if (this->negative()) return *this = -(*this + x);
-	if (digits.size() <= 2) return *this -= BigInteger(x);
-	digits[0] -= x;
-	if (digits[0] >= 0) return *this;
-	digits[0] += BASE;
-	int i = 1;
-	while (true) {
-		if (--digits[i] >= 0) break;
-		digits[i] += BASE, i++;
-	} 
-	return trim();
-}
-BigInteger BigInteger::operator- (const int32_t& x) const {
-	return BigInteger(*this) -= x;
-}
 BigInteger& BigInteger::operator-= (const BigInteger& x) {
-	if (x.negative()) return *this += x.abs();
-	if (this->negative()) return *this = -(x + this->abs());
-	flag = (*this >= x);
-	int n = std::max(digits.size(), x.digits.size());
-	digit_t carry = 0;
-	for (int i = 0; i < n; i++) {
-		if (i >= (int) digits.size()) digits.emplace_back(0);
-		digits[i] = flag ? (digits[i] - x[i] - carry) : (x[i] - digits[i] - carry);
-		if (digits[i] < 0) digits[i] += BASE, carry = 1;
-		else carry = 0;
-	} return trim();
+	if (this == &x) return *this = 0;
+	return add_mag(x.digits.data(), x.digits.size(), x.positive());
 }
-BigInteger BigInteger::operator- (const BigInteger& x) const {
-	return BigInteger(*this) -= x;
+BigInteger BigInteger::operator- (const BigInteger& x) const & {return BigInteger(*this) -= x;}
+BigInteger BigInteger::operator- (const BigInteger& x) && {return std::move(*this -= x);}
+BigInteger BigInteger::operator- (BigInteger&& x) const & {
+	if (this == &x) return 0;
+	return -std::move(x -= *this);
 }
+BigInteger BigInteger::operator- (BigInteger&& x) && {return std::move(*this -= x);}
 BigInteger& BigInteger::operator-- () {return *this -= 1;}
 BigInteger BigInteger::operator-- (int) {
 	BigInteger t = *this; 
 	return *this -= 1, t;
 }
 
-namespace __FFT {  // FFT implementation for faster multiplication
-	constexpr long long FFT_BASE = 1e4;
-	constexpr double PI2 = 6.283185307179586231995927;
-	constexpr double PI6 = 18.84955592153875869598778;
-	constexpr int RBASE = 1023;  // The frequency of recalculate the unit roots, must be 2^k-1
-	struct complex {
-		double real, imag;
-		complex(double x = 0.0, double y = 0.0) : real(x), imag(y) {}
-		complex operator+ (const complex& other) const {return complex(real + other.real, imag + other.imag);}
-		complex operator- (const complex& other) const {return complex(real - other.real, imag - other.imag);}
-		complex operator* (const complex& other) const {return complex(real * other.real - imag * other.imag, 
-			real * other.imag + other.real * imag);}
-		complex& operator+= (const complex& other) {return real += other.real, imag += other.imag, *this;}
-		complex& operator-= (const complex& other) {return real -= other.real, imag -= other.imag, *this;}
-		complex& operator*= (const complex& other) {return *this = *this * other;}
-		inline complex conj() const {return complex(imag, -real);}
+namespace __POOL {  // Work-stealing thread pool behind the opt-in parallel mode, see set_parallel()
+	struct task {
+		std::function<void()> f;
+		std::atomic<bool> done{false};
+		std::exception_ptr error;
+		explicit task(std::function<void()> f) : f(std::move(f)) {}
+		void run() {
+			try {f();} catch (...) {error = std::current_exception();}
+			done.store(true, std::memory_order_release);
+		}
 	};
-	template <const int n> inline void fft(complex* a) {
-		const int n2 = n >> 1, n4 = n >> 2;
-		complex w(1.0, 0.0), w3(1.0, 0.0);
-		const complex wn(std::cos(PI2 / n), std::sin(PI2 / n)), wn3(std::cos(PI6 / n), std::sin(PI6 / n));
-		for (int i = 0; i < n4; i++, w *= wn, w3 *= wn3) {
-			if (!(i & RBASE)) w = complex(std::cos(PI2 * i / n), std::sin(PI2 * i / n)), w3 = w * w * w;
-			complex x = a[i] - a[i + n2], y = a[i + n4] - a[i + n2 + n4];
-			y = y.conj(), a[i] += a[i + n2], a[i + n4] += a[i + n2 + n4];
-			a[i + n2] = (x - y) * w, a[i + n2 + n4] = (x + y) * w3;
-		} fft<n2>(a), fft<n4>(a + n2), fft<n4>(a + n2 + n4);
-	}
-	template <> inline void fft<0>(complex*) {}
-	template <> inline void fft<1>(complex*) {}
-	template <> inline void fft<2>(complex* a) {complex x = a[0], y = a[1]; a[0] += y, a[1] = x - y;}
-	template <> inline void fft<4>(complex* a) {
-		complex a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], x = a0 - a2, y = a1 - a3;
-		y = y.conj(), a[0] += a2, a[1] += a3, a[2] = x - y, a[3] = x + y; 
-		fft<2>(a);
-	}
-	template <const int n> inline void ifft(complex* a) {
-		const int n2 = n >> 1, n4 = n >> 2;
-		ifft<n2>(a), ifft<n4>(a + n2), ifft<n4>(a + n2 + n4);
-		complex w(1.0, 0.0), w3(1.0, 0.0);
-		const complex wn(std::cos(PI2 / n), -std::sin(PI2 / n)), wn3(std::cos(PI6 / n), -std::sin(PI6 / n));
-		for (int i = 0; i < n4; i++, w *= wn, w3 *= wn3) {
-			if (!(i & RBASE)) w = complex(std::cos(PI2 * i / n), -std::sin(PI2 * i / n)), w3 = w * w * w;
-			complex p = w * a[i + n2], q = w3 * a[i + n2 + n4];
-			complex x = a[i], y = p + q, x1 = a[i + n4], y1 = p - q;
-			y1 = y1.conj(), a[i] += y, a[i + n4] += y1, a[i + n2] = x - y, a[i + n2 + n4] = x1 - y1;
-		}
-	}
-	template <> inline void ifft<0>(complex*) {}
-	template <> inline void ifft<1>(complex*) {}
-	template <> inline void ifft<2>(complex* a) {complex x = a[0], y = a[1]; a[0] += y, a[1] = x - y;}
-	template <> inline void ifft<4>(complex* a) {
-		ifft<2>(a); 
-		complex p = a[2], q = a[3], x = a[0], y = p + q, x1 = a[1], y1 = p - q;
-		y1 = y1.conj(), a[0] += y, a[1] += y1, a[2] = x - y, a[3] = x1 - y1;
-	}
-	inline void dft(complex* a, int n) {
-		if (n <= 1) return;
-		switch (n) {
-			case 1<<2:fft<1<<2>(a);break;
-			case 1<<3:fft<1<<3>(a);break;
-			case 1<<4:fft<1<<4>(a);break;
-			case 1<<5:fft<1<<5>(a);break;
-			case 1<<6:fft<1<<6>(a);break;
-			case 1<<7:fft<1<<7>(a);break;
-			case 1<<8:fft<1<<8>(a);break;
-			case 1<<9:fft<1<<9>(a);break;
-			case 1<<10:fft<1<<10>(a);break;
-			case 1<<11:fft<1<<11>(a);break;
-			case 1<<12:fft<1<<12>(a);break;
-			case 1<<13:fft<1<<13>(a);break;
-			case 1<<14:fft<1<<14>(a);break;
-			case 1<<15:fft<1<<15>(a);break;
-			case 1<<16:fft<1<<16>(a);break;
-			case 1<<17:fft<1<<17>(a);break;
-			case 1<<18:fft<1<<18>(a);break;
-			case 1<<19:fft<1<<19>(a);break;
-			case 1<<20:fft<1<<20>(a);break;
-			case 1<<21:fft<1<<21>(a);break;
-			throw FFTLimitExceededError();
-		}
-	}
-	inline void idft(complex* a, int n) {
-		if (n <= 1) return;
-		switch (n) {
-			case 1<<2:ifft<1<<2>(a);break;
-			case 1<<3:ifft<1<<3>(a);break;
-			case 1<<4:ifft<1<<4>(a);break;
-			case 1<<5:ifft<1<<5>(a);break;
-			case 1<<6:ifft<1<<6>(a);break;
-			case 1<<7:ifft<1<<7>(a);break;
-			case 1<<8:ifft<1<<8>(a);break;
-			case 1<<9:ifft<1<<9>(a);break;
-			case 1<<10:ifft<1<<10>(a);break;
-			case 1<<11:ifft<1<<11>(a);break;
-			case 1<<12:ifft<1<<12>(a);break;
-			case 1<<13:ifft<1<<13>(a);break;
-			case 1<<14:ifft<1<<14>(a);break;
-			case 1<<15:ifft<1<<15>(a);break;
-			case 1<<16:ifft<1<<16>(a);break;
-			case 1<<17:ifft<1<<17>(a);break;
-			case 1<<18:ifft<1<<18>(a);break;
-			case 1<<19:ifft<1<<19>(a);break;
-			case 1<<20:ifft<1<<20>(a);break;
-			case 1<<21:ifft<1<<21>(a);break;
-			throw FFTLimitExceededError();
+	class pool {  // Each thread pops the newest task of its own deque and steals the oldest ones of the others
+		struct queue {std::mutex lock; std::deque<task*> q;};
+		int size;  // Workers, queues[size] is shared by the threads outside the pool
+		std::unique_ptr<queue[]> queues;
+		std::vector<std::thread> workers;
+		std::atomic<int> pending{0};
+		bool stop = false;
+		std::mutex sleep;
+		std::condition_variable wake;
+		
+		static int& index() {static thread_local int id = -1; return id;}
+		int self() const {int id = index(); return id >= 0 && id < size ? id : size;}
+		task* pop(int i, bool newest) {
+			std::lock_guard<std::mutex> guard(queues[i].lock);
+			std::deque<task*>& q = queues[i].q;
+			if (q.empty()) return nullptr;
+			task* t = newest ? q.back() : q.front();
+			newest ? q.pop_back() : q.pop_front();
+			return pending--, t;
 		}
+		task* take(int id) {
+			task* t = pop(id, true);
+			for (int k = 1; !t && k <= size; k++) t = pop((id + k) % (size + 1), false);
+			return t;
+		}
+		void loop(int id) {
+			index() = id;
+			for (;;) {
+				if (task* t = take(id)) {t->run(); continue;}
+				std::unique_lock<std::mutex> guard(sleep);
+				wake.wait(guard, [this] {return stop || pending > 0;});
+				if (stop) return;
+			}
+		}
+	public:
+		explicit pool(int n) : size(n), queues(new queue[n + 1]) {
+			for (int i = 0; i < n; i++) workers.emplace_back(&pool::loop, this, i);
+		}
+		~pool() {
+			{std::lock_guard<std::mutex> guard(sleep); stop = true;}
+			wake.notify_all();
+			for (std::thread& t : workers) t.join();
+		}
+		int threads() const {return size + 1;}
+		void push(task* t) {
+			{std::lock_guard<std::mutex> guard(queues[self()].lock); queues[self()].q.push_back(t);}
+			{std::lock_guard<std::mutex> guard(sleep); pending++;}
+			wake.notify_one();
+		}
+		void wait(task* t) {  // Run t here if nobody took it, otherwise help with other tasks until it is done
+			while (!t->done.load(std::memory_order_acquire)) {
+				if (task* x = take(self())) x->run();
+				else std::this_thread::yield();
+			}
+		}
+	};
+	
+	inline std::unique_ptr<pool> active;  // nullptr while single-threaded
+	inline int64_t limit = INT64_MAX;
+	inline bool enabled(int64_t size) {return active && size >= limit;}
+	inline int threads() {return active ? active->threads() : 1;}
+	
+	// Run f(0), f(1), ..., f(k - 1) in parallel and return when all are done, rethrowing the first exception.
+	// Code holding a thread's workspace must not call this, as the waiting thread may run other tasks meanwhile
+	template <typename F> inline void for_each(int k, const F& f) {
+		std::deque<task> ts;
+		for (int i = 1; i < k; i++) ts.emplace_back([&f, i] {f(i);}), active->push(&ts.back());
+		std::exception_ptr error;
+		try {f(0);} catch (...) {error = std::current_exception();}
+		for (auto t = ts.rbegin(); t != ts.rend(); ++t) {
+			active->wait(&*t);
+			if (!error) error = t->error;
+		}
+		if (error) std::rethrow_exception(error);
+	}
+	template <typename F, typename G> inline void invoke(const F& f, const G& g) {
+		for_each(2, [&](int i) {i ? g() : f();});
+	}
+	template <typename F> inline void for_range(int n, int align, const F& f) {  // f(lo, hi) over chunks of [0, n)
+		int k = std::max(1, std::min(threads() * 2, n / align)), step = std::max(align, (n / k + align - 1) / align * align);
+		for_each((n + step - 1) / step, [&](int i) {f(i * step, std::min(n, i * step + step));});
 	}
 }
 
-BigInteger BigInteger::fft_mul(const BigInteger& a, const BigInteger& b) {
-	int n = a.digits.size(), m = b.digits.size();
-	int least = (n + m) << 1, lim = 1;
-	while (lim < least) lim <<= 1;
-	
-	__FFT::complex* arr = new __FFT::complex[lim];
-	for (int i = 0; i < n; i++) {
-		arr[i << 1].real = a.digits[i] % 10000LL;
-		arr[i << 1 | 1].real = a.digits[i] / 10000LL % 10000LL;
+namespace __MUL {  // Schoolbook, Karatsuba and Toom-Cook kernels on little-endian arrays of BASE limbs
+	inline digit_t* workspace(size_t n) {  // Scratch kept by each thread for products that do not fork, not zeroed
+		static thread_local std::vector<digit_t> pool;
+		if (pool.size() < n) pool = std::vector<digit_t>(n);
+		return pool.data();
+	}
+	inline void normalize(digit_t* r, int n) {  // Propagate the carries, the result must fit in n limbs
+		digit_t carry = 0;
+		for (int i = 0; i < n; i++) r[i] += carry, carry = r[i] / BASE, r[i] %= BASE;
+	}
+	inline int compare(const digit_t* a, int n, const digit_t* b, int m) {
+		for (; n > m; n--) if (a[n - 1]) return 1;
+		for (; m > n; m--) if (b[m - 1]) return -1;
+		for (int i = n - 1; i >= 0; i--) if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+		return 0;
+	}
+	inline digit_t add(digit_t* r, const digit_t* a, int n, const digit_t* b, int m) {  // r = a + b with n >= m, returns the carry
+		digit_t carry = 0;
+		for (int i = 0; i < m; i++) r[i] = a[i] + b[i] + carry, carry = r[i] >= BASE, r[i] -= carry * BASE;
+		for (int i = m; i < n; i++) r[i] = a[i] + carry, carry = r[i] >= BASE, r[i] -= carry * BASE;
+		return carry;
+	}
+	inline digit_t sub(digit_t* r, const digit_t* a, int n, const digit_t* b, int m) {  // r = a - b with n >= m, returns the borrow
+		digit_t borrow = 0;
+		for (int i = 0; i < m; i++) r[i] = a[i] - b[i] - borrow, borrow = r[i] < 0, r[i] += borrow * BASE;
+		for (int i = m; i < n; i++) r[i] = a[i] - borrow, borrow = r[i] < 0, r[i] += borrow * BASE;
+		return borrow;
+	}
+	inline void add_to(digit_t* r, int rn, const digit_t* a, int an) {  // r += a, the sum must fit in rn limbs
+		digit_t carry = add(r, r, an, a, an);
+		for (int i = an; carry && i < rn; i++) r[i] += carry, carry = r[i] >= BASE, r[i] -= carry * BASE;
+	}
+	inline bool diff(digit_t* r, const digit_t* a, int n, const digit_t* b, int m) {  // r[0, n) = |a - b| with n >= m, returns a < b
+		if (compare(a, n, b, m) >= 0) return sub(r, a, n, b, m), false;
+		sub(r, b, m, a, m), std::fill(r + m, r + n, 0);
+		return true;
 	}
-	for (int i = 0; i < m; i++) {
-		arr[i << 1].imag = b.digits[i] % 10000LL;
-		arr[i << 1 | 1].imag = b.digits[i] / 10000LL % 10000LL;
-	}
-	__FFT::dft(arr, lim);
-	for (int i = 0; i < lim; i++) arr[i] *= arr[i];
-	__FFT::idft(arr, lim);
-	
-	std::vector<digit_t> res(n + m + 1);
-	digit_t carry = 0;
-	double inv = 0.5 / lim;
-	for (int i = 0; i <= n + m; i++) {
-		carry += digit_t(arr[i << 1].imag * inv + 0.5);
-		carry += digit_t(arr[i << 1 | 1].imag * inv + 0.5) * 10000LL;
-		res[i] += carry % BASE, carry /= BASE;
-	} 
-	delete[] arr;
-	return res;
-}
 
-BigInteger BigInteger::operator* (const BigInteger& x) const {
-	if (zero() || x.zero()) return BigInteger();
-	int n = digits.size(), m = x.digits.size();
-	if (1LL * n * m >= FFT_LIMIT) {
-		BigInteger res = fft_mul(*this, x);
-		return res.flag = !(flag ^ x.flag), res;
-	}  // When n * m < FFT_LIMIT, using normal multiplication
-	std::vector<digit_t> res(n + m + 1);
-	for (int i = 0; i < n; i++) {
-		for (int j = 0; j < m; j++) {
-			res[i + j] += digits[i] * x.digits[j];
-			res[i + j + 1] += res[i + j] / BASE, res[i + j] %= BASE;
+	inline void basecase(const digit_t* a, int n, const digit_t* b, int m, digit_t* r) {  // r[0, n + m) = a * b
+		std::fill(r, r + n + m, 0);
+		for (int j = 0; j < m; j++) {  // Each column gathers at most 512 products between two normalizations
+			digit_t y = b[j], *c = r + j;
+			for (int i = 0; i < n; i++) c[i] += a[i] * y;
+			if ((j & 511) == 511) normalize(r, n + m);
 		}
-	} 
-	BigInteger u(res);
-	return u.flag = !(flag ^ x.flag), u;
-}
-BigInteger& BigInteger::operator*= (const BigInteger& x) {
-	return *this = *this * x;
-}
-BigInteger BigInteger::square() const {  // Calculate the square, faster than a * a
-	if (zero()) return BigInteger();
-	int n = digits.size();
-	if (1LL * n * n < FFT_LIMIT) {  // When n * n < FFT_LIMIT, using normal multiplication
-		std::vector<digit_t> res((n << 1) + 1);
+		normalize(r, n + m);
+	}
+	inline void basecase_sqr(const digit_t* a, int n, digit_t* r) {  // r[0, 2n) = a^2, n < 512
+		std::fill(r, r + (n << 1), 0);
 		for (int i = 0; i < n; i++) {
-			for (int j = 0; j < n; j++) {
-				res[i + j] += digits[i] * digits[j];
-				res[i + j + 1] += res[i + j] / BASE, res[i + j] %= BASE;
-			}
-		} 
-		return res;
+			digit_t y = a[i], *c = r + i;
+			for (int j = i + 1; j < n; j++) c[j] += a[j] * y;
+		}
+		for (int i = 0; i < (n << 1); i++) r[i] <<= 1;
+		for (int i = 0; i < n; i++) r[i << 1] += a[i] * a[i];
+		normalize(r, n << 1);
 	}
-	int least = n << 2, lim = 1;
-	while (lim < least) lim <<= 1;
-	
-	__FFT::complex* arr = new __FFT::complex[lim];
-	for (int i = 0; i < n; i++) {
-		arr[i << 1].real = arr[i << 1].imag = digits[i] % 10000LL;
-		arr[i << 1 | 1].real = arr[i << 1 | 1].imag = digits[i] / 10000LL % 10000LL;
-	}
-	__FFT::dft(arr, lim);
-	for (int i = 0; i < lim; i++) arr[i] *= arr[i];
-	__FFT::idft(arr, lim);
-	
-	std::vector<digit_t> res((n << 1) + 1);
-	digit_t carry = 0;
-	double inv = 0.5 / lim;
-	for (int i = 0; i <= (n << 1); i++) {
-		carry += digit_t(arr[i << 1].imag * inv + 0.5);
-		carry += digit_t(arr[i << 1 | 1].imag * inv + 0.5) * 10000LL;
-		res[i] += carry % BASE, carry /= BASE;
-	} 
-	delete[] arr;
-	return res;
-}
 
-BigInteger& BigInteger::operator*= (int32_t x) {
-	if (x == 0 || zero()) return *this = 0;
-	if (x < 0) flag ^= 1, x = -x;
-	digit_t carry = 0;
-	for (int i = 0; i < (int) digits.size() || carry != 0; i++) {
-		if (i >= (int) digits.size()) digits.emplace_back(0);
-		digits[i] = digits[i] * x + carry; 
-		carry = digits[i] / BASE, digits[i] %= BASE;
+	inline void mul_1(digit_t* r, const digit_t* a, int n, digit_t x) {  // r = a * x, the product must fit in n limbs
+		digit_t carry = 0;
+		for (int i = 0; i < n; i++) r[i] = a[i] * x + carry, carry = r[i] / BASE, r[i] %= BASE;
+	}
+	inline digit_t addmul_1(digit_t* r, const digit_t* a, int n, digit_t x) {  // r[0, n) += a * x, returns the carry
+		digit_t carry = 0;
+		for (int i = 0; i < n; i++) carry += r[i] + a[i] * x, r[i] = carry % BASE, carry /= BASE;
+		return carry;
+	}
+	inline digit_t submul_1(digit_t* r, const digit_t* a, int n, digit_t x) {  // r[0, n) -= a * x, returns the borrow
+		digit_t borrow = 0;
+		for (int i = 0; i < n; i++) {
+			digit_t t = a[i] * x + borrow;
+			r[i] -= t % BASE, borrow = t / BASE;
+			if (r[i] < 0) r[i] += BASE, borrow++;
+		}
+		return borrow;
+	}
+	inline void divexact_1(digit_t* a, int n, digit_t x) {  // a /= x, x must divide a and x < 2^16
+		digit_t cur = 0;
+		for (int i = n - 1; i >= 0; i--) cur = cur * BASE + a[i], a[i] = cur / x, cur %= x;
+	}
+	// r = (an ? -a : a) + (bn ? -b : b) on fixed-length signed magnitudes, returns whether r is negative
+	inline bool add_signed(digit_t* r, const digit_t* a, bool an, const digit_t* b, bool bn, int n) {
+		if (an == bn) return add(r, a, n, b, n), an;
+		if (compare(a, n, b, n) >= 0) return sub(r, a, n, b, n), an;
+		return sub(r, b, n, a, n), bn;
 	}
-	return trim();
-} 
-BigInteger BigInteger::operator* (const int32_t& x) const {
-	return BigInteger(*this) *= x;
-}
 
-BigInteger BigInteger::half() const {
-	BigInteger res = *this;
-	for (int i = digits.size() - 1; i >= 0; i--) {
-		if ((res[i] & 1) && i > 0) res.digits[i - 1] += BASE;
-		res.digits[i] >>= 1;
-	} 
-	return res.trim();
-}
-BigInteger& BigInteger::operator/= (int64_t x) {
-	if (x == 0) throw ZeroDivisionError();
-	if (zero()) return *this;
-	if (x < 0) flag ^= 1, x = -x;
-	digit_t cur = 0;
-	for (int i = digits.size() - 1; i >= 0; i--) {
-		cur = cur * BASE + digits[i];
-		digits[i] = flag ? (cur / x) : (-cur / -x);
-		cur %= x;
+	// r[0, n + m) = a * b, tmp must hold 6 * (n + m) + 256 limbs
+	inline void multiply(const digit_t* a, int n, const digit_t* b, int m, digit_t* r, digit_t* tmp);
+	inline void square(const digit_t* a, int n, digit_t* r, digit_t* tmp);
+	inline void karatsuba(const digit_t* a, int n, const digit_t* b, int m, digit_t* r, digit_t* tmp) {  // n >= m > (n + 1) / 2
+		int h = (n + 1) >> 1;
+		digit_t *da = tmp, *db = tmp + h, *p = tmp + 2 * h, *mid = tmp + 4 * h, *next = tmp + 6 * h + 1;
+		bool neg = diff(da, a, h, a + h, n - h) == diff(db, b, h, b + h, m - h);  // The sign of (a0 - a1)(b1 - b0)
+		if (__POOL::enabled(n + m)) {  // The three products in parallel, each with its own scratch
+			std::vector<digit_t> t1(12 * h + 256), t2(12 * h + 256);
+			__POOL::for_each(3, [&](int i) {
+				if (i == 0) multiply(a, h, b, h, r, next);
+				else if (i == 1) multiply(a + h, n - h, b + h, m - h, r + 2 * h, t1.data());
+				else multiply(da, h, db, h, p, t2.data());
+			});
+		} else multiply(a, h, b, h, r, next), multiply(a + h, n - h, b + h, m - h, r + 2 * h, next), multiply(da, h, db, h, p, next);
+		mid[2 * h] = add(mid, r, 2 * h, r + 2 * h, n + m - 2 * h);
+		if (neg) sub(mid, mid, 2 * h + 1, p, 2 * h);
+		else add(mid, mid, 2 * h + 1, p, 2 * h);
+		add_to(r + h, n + m - h, mid, std::min(2 * h + 1, n + m - h));
 	}
-	return trim();
-} 
-BigInteger BigInteger::operator/ (const int64_t& x) const {
-	return BigInteger(*this) /= x;
-}
 
-BigInteger BigInteger::newton_inv(int n) const {  // Solve BASE^n / x
-	if (zero()) throw ZeroDivisionError();
-	int sz = digits.size();
-	if (std::min(sz, n - sz) <= NEWTON_DIV_MIN_LEVEL) {
-		std::vector<digit_t> a(n + 1);
-		a[n] = 1;
-		return BigInteger(a).divmod(*this).first;
+	// Toom-3: cut x[0, n) into 3 parts of k limbs and evaluate them at 1, -1, -2 into v[(i - 1) * l, i * l),
+	// the values at 0 and inf are the low and high parts themselves
+	inline void toom_eval(const digit_t* x, int n, int k, digit_t* v, bool* neg, digit_t* tmp) {
+		int l = k + 1;
+		digit_t *p = tmp, *s = tmp + 3 * l, *t = s + l;
+		std::fill(p, p + 3 * l, 0);
+		for (int i = 0; i < 3 && i * k < n; i++) std::copy(x + i * k, x + std::min(n, i * k + k), p + i * l);
+		std::fill(neg, neg + 5, false);
+		add(s, p, l, p + 2 * l, l);
+		add(v, s, l, p + l, l), neg[2] = add_signed(v + l, s, false, p + l, true, l);
+		neg[3] = add_signed(t, v + l, neg[2], p + 2 * l, false, l), mul_1(t, t, l, 2);
+		neg[3] = add_signed(v + 2 * l, t, neg[3], p, true, l);
 	}
-	int k = (n - sz + 2) >> 1, k2 = k > sz ? 0 : sz - k; 
-	BigInteger x = _move_r(k2); 
-	int n2 = k + x.digits.size(); 
-	BigInteger y = x.newton_inv(n2), a = y + y, b = (*this) * y * y;
-	return a._move_l(n - n2 - k2) - b._move_r(2 * (n2 + k2) - n) - 1;
-}
-std::pair<BigInteger, BigInteger> BigInteger::divmod(const BigInteger& x) const {
-	BigInteger a = abs(), b = x.abs();
-	if (b == 0) throw ZeroDivisionError();
-	if (a < b) return std::make_pair(0, flag ? a : -a);
-	int n = a.digits.size(), m = b.digits.size();
-	
-	if (std::min(n, n - m) > NEWTON_DIV_LIMIT) {
-		int k = n - m + 2, k2 = std::max(0, m - k);
-		BigInteger b2 = b._move_r(k2);
-		if (k2 != 0) b2 += 1;
-		int n2 = k + b2.digits.size();
-		BigInteger u = a * b2.newton_inv(n2), q = u._move_r(n2 + k2), r = (*this) - q * b;
-		while (r >= b) q += 1, r -= b;
-		q.flag = !(flag ^ x.flag), r.flag = flag;
-		return std::make_pair(q, r);
+	inline void toom(const digit_t* a, int n, const digit_t* b, int m, digit_t* r, digit_t* tmp) {  // n >= m > n / 2, tmp as in multiply
+		int k = (n + 2) / 3, l = k + 1, L = 2 * l + 1, w = 5;  // Each of the w points is a product of at most L limbs
+		digit_t *va = tmp, *vb = va + 3 * l, *c = vb + 3 * l, *next = c + w * L, *t = next;  // t is used once the products are done
+		bool na[5], nb[5], nc[5];
+		toom_eval(a, n, k, va, na, next);
+		if (a != b) toom_eval(b, m, k, vb, nb, next);
+		for (int i = 0; i < w; i++) std::fill(c + i * L, c + i * L + L, 0), nc[i] = na[i] ^ (a == b ? na[i] : nb[i]);
+		auto point = [&](int i, digit_t* scratch) {
+			if (i == 0) {  // The low parts
+				if (a == b) square(a, k, c, scratch);
+				else multiply(a, k, b, k, c, scratch);
+			} else if (i == w - 1) {  // The high parts, possibly empty
+				if (a == b && n > 2 * k) square(a + 2 * k, n - 2 * k, c + i * L, scratch);
+				else if (a != b && m > 2 * k) multiply(a + 2 * k, n - 2 * k, b + 2 * k, m - 2 * k, c + i * L, scratch);
+			} else if (a == b) square(va + (i - 1) * l, l, c + i * L, scratch);
+			else multiply(va + (i - 1) * l, l, vb + (i - 1) * l, l, c + i * L, scratch);
+		};
+		if (__POOL::enabled(n + m)) __POOL::for_each(w, [&](int i) {std::vector<digit_t> own(12 * l + 256); point(i, own.data());});
+		else for (int i = 0; i < w; i++) point(i, next);
+		// Bodrato's interpolation, c1, c2, c3 are the values at 1, -1, -2
+		digit_t *c0 = c, *c1 = c + L, *c2 = c + 2 * L, *c3 = c + 3 * L, *c4 = c + 4 * L;
+		bool n3 = add_signed(t, c3, nc[3], c1, true, L);
+		divexact_1(t, L, 3), nc[1] = add_signed(c1, c1, false, c2, !nc[2], L), divexact_1(c1, L, 2);
+		nc[2] = add_signed(c2, c2, nc[2], c0, true, L);
+		n3 = add_signed(c3, c2, nc[2], t, !n3, L), divexact_1(c3, L, 2);
+		mul_1(t, c4, L, 2), nc[3] = add_signed(c3, c3, n3, t, false, L);
+		nc[2] = add_signed(c2, c2, nc[2], c1, nc[1], L), nc[2] = add_signed(c2, c2, nc[2], c4, true, L);
+		nc[1] = add_signed(c1, c1, nc[1], c3, !nc[3], L);
+		std::fill(r, r + n + m, 0);
+		for (int i = 0; i < w && i * k < n + m; i++) add_to(r + i * k, n + m - i * k, c + i * L, std::min(L, n + m - i * k));
 	}
-	
-	int32_t t = BASE / (x.digits.back() + 1);
-	a *= t, b *= t, n = a.digits.size(), m = b.digits.size();
-	BigInteger q = 0, r = 0; 
-	q.digits.resize(n);
-	for (int i = n - 1; i >= 0; i--) {
-		r = r * BASE + a.digits[i];
-		digit_t d1 = r[m], d2 = r[m - 1], d = (d1 * BASE + d2) / b.digits.back(); 
-		r -= b * d;
-		while (r.negative()) r += b, d--; 
-		q.digits[i] = d;
+
+	inline void multiply(const digit_t* a, int n, const digit_t* b, int m, digit_t* r, digit_t* tmp) {
+		if (n < m) std::swap(a, b), std::swap(n, m);
+		if (m < KARATSUBA_LIMIT) return basecase(a, n, b, m, r);
+		if (m > (n + 1) >> 1) {
+			if (m < TOOM3_LIMIT) return karatsuba(a, n, b, m, r, tmp);
+			return toom(a, n, b, m, r, tmp);
+		}
+		std::fill(r, r + n + m, 0);  // Unbalanced, cut a into blocks of m limbs
+		if (__POOL::enabled(n + m)) {  // Each thread sums a run of blocks, the runs are added at the end
+			int k = (n + m - 1) / m, step = (k + __POOL::threads() - 1) / __POOL::threads() * m;
+			std::vector<std::vector<digit_t>> part((n + step - 1) / step);
+			__POOL::for_each(part.size(), [&](int t) {
+				int s = t * step, len = std::min(step, n - s);
+				std::vector<digit_t> own(6 * (len + m) + 256);
+				part[t].resize(len + m), multiply(a + s, len, b, m, part[t].data(), own.data());
+			});
+			for (size_t t = 0; t < part.size(); t++) add_to(r + t * step, n + m - t * step, part[t].data(), part[t].size());
+			return;
+		}
+		digit_t* blk = tmp;
+		for (int i = 0; i < n; i += m) {
+			int len = std::min(m, n - i);
+			multiply(a + i, len, b, m, blk, tmp + 2 * m);
+			add_to(r + i, n + m - i, blk, len + m);
+		}
+	}
+	inline void square(const digit_t* a, int n, digit_t* r, digit_t* tmp) {  // r[0, 2n) = a^2, tmp as above
+		if (n < KARATSUBA_LIMIT) return basecase_sqr(a, n, r);
+		if (n >= TOOM3_LIMIT) return toom(a, n, a, n, r, tmp);
+		int h = (n + 1) >> 1;
+		digit_t *d = tmp, *p = tmp + h, *mid = tmp + 3 * h, *next = tmp + 5 * h + 1;
+		diff(d, a, h, a + h, n - h);
+		if (__POOL::enabled(n << 1)) {
+			std::vector<digit_t> t1(12 * h + 256), t2(12 * h + 256);
+			__POOL::for_each(3, [&](int i) {
+				if (i == 0) square(a, h, r, next);
+				else if (i == 1) square(a + h, n - h, r + 2 * h, t1.data());
+				else square(d, h, p, t2.data());
+			});
+		} else square(a, h, r, next), square(a + h, n - h, r + 2 * h, next), square(d, h, p, next);
+		mid[2 * h] = add(mid, r, 2 * h, r + 2 * h, 2 * (n - h));
+		sub(mid, mid, 2 * h + 1, p, 2 * h);
+		add_to(r + h, 2 * n - h, mid, std::min(2 * h + 1, 2 * n - h));
 	}
-	q.trim(), q.flag = !(flag ^ x.flag), r.flag = flag;
-	return std::make_pair(q, r / t);
 }
 
-BigInteger BigInteger::operator/ (const BigInteger& x) const {
-	return divmod(x).first;
-}
-BigInteger& BigInteger::operator/= (const BigInteger& x) {
-	return *this = divmod(x).first;
-}
-BigInteger BigInteger::operator% (const BigInteger& x) const {
-	return divmod(x).second;
-}
-BigInteger& BigInteger::operator%= (const BigInteger& x) {
-	return *this = divmod(x).second;
+namespace __DIV {  // Schoolbook division on little-endian arrays of BASE limbs
+	// q[0, n - m + 1) = a / b and a[0, m) = a % b, where a has n + 1 limbs with a[n] = 0, and b has m >= 2 limbs
+	// with b[m - 1] >= BASE / 2. Each quotient limb is estimated from the top limbs and is at most one too large
+	inline void basecase(digit_t* a, int n, const digit_t* b, int m, digit_t* q) {
+		const digit_t bt = b[m - 1], bs = b[m - 2];
+		for (int j = n - m; j >= 0; j--) {
+			digit_t* r = a + j, num = r[m] * BASE + r[m - 1], qh = num / bt, rh = num % bt;
+			if (qh >= BASE) qh = BASE - 1, rh = num - qh * bt;
+			while (rh < BASE && qh * bs > rh * BASE + r[m - 2]) qh--, rh += bt;
+			digit_t carry = 0, borrow = 0;
+			for (int i = 0; i < m; i++) {  // r[0, m] -= qh * b
+				digit_t p = qh * b[i] + carry, t = r[i] - p % BASE - borrow;
+				carry = p / BASE, borrow = t < 0, r[i] = t + borrow * BASE;
+			}
+			r[m] -= carry + borrow;
+			if (r[m] < 0) {  // Add b back once
+				carry = 0, qh--;
+				for (int i = 0; i < m; i++) r[i] += b[i] + carry, carry = r[i] >= BASE, r[i] -= carry * BASE;
+				r[m] += carry;
+			}
+			q[j] = qh;
+		}
+	}
+	
+	inline digit_t inverse(digit_t x) {  // x^-1 mod BASE for x coprime to 10, lifted from mod 10 by Newton's iteration
+		digit_t y = x % 10 == 3 ? 7 : x % 10 == 7 ? 3 : x % 10;
+		for (int i = 0; i < 3; i++) y = y * ((2 - x * y % BASE + BASE) % BASE) % BASE;
+		return y;
+	}
+	// q[0, k) = a / b mod BASE^k by Jebelean's exact division from the low limbs, where a has k limbs, which are
+	// overwritten, and b[0] is coprime to 10. Only the low k limbs of b are read
+	inline void hensel(digit_t* a, int k, const digit_t* b, int m, digit_t* q) {
+		const digit_t inv = inverse(b[0]);
+		for (int i = 0; i < k; i++) {
+			digit_t qh = q[i] = a[i] * inv % BASE, carry = 0, borrow = 0;
+			int len = std::min(m, k - i), j = 0;
+			for (digit_t* r = a + i; j < len; j++) {  // r[0, k - i) -= qh * b
+				digit_t p = qh * b[j] + carry, t = r[j] - p % BASE - borrow;
+				carry = p / BASE, borrow = t < 0, r[j] = t + borrow * BASE;
+			}
+			for (j += i; (carry | borrow) && j < k; j++) {
+				digit_t t = a[j] - carry - borrow;
+				carry = 0, borrow = t < 0, a[j] = t + borrow * BASE;
+			}
+		}
+	}
 }
 
-BigInteger BigInteger::pow(int64_t b) const {
-	BigInteger a = *this, res = 1;
-	for (; b; b >>= 1) {
-		if (b & 1) res *= a;
-		a = a.square();
-	} return res;
-}
-BigInteger BigInteger::pow(int64_t b, const BigInteger& p) const {
-	BigInteger a = *this % p, res = 1;
-	for (; b; b >>= 1) {
-		if (b & 1) res = res * a % p;
-		a = a.square() % p;
-	} return res;
-}
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__) && !defined(__SANITIZE_THREAD__)
+#define BIGINTEGER_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))  // One clone per ISA, picked at load time
+#else
+#define BIGINTEGER_TARGET_CLONES
+#endif
+#ifdef __GNUC__
+#define BIGINTEGER_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define BIGINTEGER_ALWAYS_INLINE inline
+#endif
 
-BigInteger BigInteger::sqrt_normal() const {
-	BigInteger x0 = BigInteger(BASE)._move_l((digits.size() + 2) >> 1);
-	BigInteger x = (x0 + *this / x0).half();
-	while (x < x0) std::swap(x, x0), x = (x0 + *this / x0).half();
-	return x0;
-}
-BigInteger BigInteger::newton_invsqrt() const {	  // Solve BASE^2k / sqrt(x)
-	int n = digits.size(), n2 = n + (n & 1), k2 = (n2 + 2) / 4 * 2;
-	if (n <= NEWTON_SQRT_MIN_LEVEL) return BigInteger(1)._move_l(n2 << 1) / this->_move_l(n2 << 1).sqrt_normal();
+namespace __FFT {  // Split-radix FFT on separate real and imaginary arrays for faster multiplication
+	constexpr long long FFT_BASE = 1e4;
+	constexpr double PI2 = 6.283185307179586231995927;
+	constexpr double PI6 = 18.84955592153875869598778;
+	constexpr int lg(int n) {return n > 1 ? lg(n >> 1) + 1 : 0;}
+#ifdef __GNUC__
+	constexpr int LANES = 8;  // Split by the compiler into as many registers as the target needs
+	typedef double vec __attribute__((vector_size(LANES * sizeof(double))));
+#else
+	constexpr int LANES = 1;  // Scalar loops only
+#endif
+	
+	// [re w_n^i | im w_n^i | re w_n^3i | im w_n^3i] for i < n / 4 with n = 2^k, built on first use and shared by all threads
+	inline const double* roots(int k) {
+		static std::atomic<double*> table[32];
+		static std::mutex lock;
+		double* r = table[k].load(std::memory_order_acquire);
+		if (r) return r;
+		std::lock_guard<std::mutex> guard(lock);
+		if ((r = table[k].load(std::memory_order_relaxed))) return r;
+		int n = 1 << k, n4 = n >> 2;
+		r = new double[n];
+		for (int i = 0; i < n4; i++) {
+			r[i] = std::cos(PI2 * i / n), r[i + n4] = std::sin(PI2 * i / n);
+			r[i + 2 * n4] = std::cos(PI6 * i / n), r[i + 3 * n4] = std::sin(PI6 * i / n);
+		}
+		return table[k].store(r, std::memory_order_release), r;
+	}
+	inline double* workspace(size_t n, int id) {  // Scratch arrays (id < 4) kept by each thread for reuse, not zeroed
+		static thread_local std::vector<double> pool[4];
+		if (pool[id].size() < n) pool[id] = std::vector<double>(n);
+		return pool[id].data();
+	}
+	inline void split(const digit_t* a, int n, double* x) {  // Each limb as two digits in base 10^4
+		for (int i = 0; i < n; i++) x[i << 1] = a[i] % 10000LL, x[i << 1 | 1] = a[i] / 10000LL % 10000LL;
+	}
+	inline void join(const double* x, int n, digit_t* res) {  // res[0, n) and the carry beyond from x after scale()
+		digit_t carry = 0;
+		for (int i = 0; i < n; i++) {
+			carry += digit_t(x[i << 1]) + digit_t(x[i << 1 | 1]) * 10000LL;
+			res[i] = carry % BASE, carry /= BASE;
+		}
+		for (int i = n; carry != 0; i++) res[i] = carry % BASE, carry /= BASE;
+	}
 	
-	BigInteger x2k(std::vector<digit_t>(digits.begin() + n2 - k2, digits.end()));
-	BigInteger s = x2k.newton_invsqrt()._move_l((n2 - k2) / 2);
-	BigInteger x2 = (s + s + s).half() - (s * s * s * *this).half()._move_r(n2 << 1);
-	BigInteger rx = BigInteger(1)._move_l(n2 << 1) - *this * x2.square(), delta = 1;
+	// Butterflies over the four quarters of a at offset i, with T = double for one lane or vec for LANES lanes
+	template <typename T> BIGINTEGER_ALWAYS_INLINE void load(T& x, const double* p) {std::memcpy(&x, p, sizeof(T));}
+	template <typename T> BIGINTEGER_ALWAYS_INLINE void store(double* p, const T& x) {std::memcpy(p, &x, sizeof(T));}
+	template <typename T> BIGINTEGER_ALWAYS_INLINE void fwd(double* re, double* im, int i, int n4, const double* r) {
+		T ar, ai, br, bi, cr, ci, dr, di, wr, wi, w3r, w3i;
+		load(ar, re + i), load(ai, im + i), load(br, re + i + n4), load(bi, im + i + n4);
+		load(cr, re + i + 2 * n4), load(ci, im + i + 2 * n4), load(dr, re + i + 3 * n4), load(di, im + i + 3 * n4);
+		load(wr, r + i), load(wi, r + i + n4), load(w3r, r + i + 2 * n4), load(w3i, r + i + 3 * n4);
+		T xr = ar - cr, xi = ai - ci, yr = br - dr, yi = bi - di;  // (x + i * y) * w and (x - i * y) * w3
+		T ur = xr - yi, ui = xi + yr, vr = xr + yi, vi = xi - yr;
+		store(re + i, ar + cr), store(im + i, ai + ci), store(re + i + n4, br + dr), store(im + i + n4, bi + di);
+		store(re + i + 2 * n4, T(ur * wr - ui * wi)), store(im + i + 2 * n4, T(ur * wi + ui * wr));
+		store(re + i + 3 * n4, T(vr * w3r - vi * w3i)), store(im + i + 3 * n4, T(vr * w3i + vi * w3r));
+	}
+	template <typename T> BIGINTEGER_ALWAYS_INLINE void inv(double* re, double* im, int i, int n4, const double* r) {
+		T ar, ai, br, bi, cr, ci, dr, di, wr, wi, w3r, w3i;
+		load(ar, re + i), load(ai, im + i), load(br, re + i + n4), load(bi, im + i + n4);
+		load(cr, re + i + 2 * n4), load(ci, im + i + 2 * n4), load(dr, re + i + 3 * n4), load(di, im + i + 3 * n4);
+		load(wr, r + i), load(wi, r + i + n4), load(w3r, r + i + 2 * n4), load(w3i, r + i + 3 * n4);
+		T pr = cr * wr + ci * wi, pi = ci * wr - cr * wi, qr = dr * w3r + di * w3i, qi = di * w3r - dr * w3i;
+		T yr = pr + qr, yi = pi + qi, zr = pi - qi, zi = qr - pr;
+		store(re + i, ar + yr), store(im + i, ai + yi), store(re + i + n4, br + zr), store(im + i + n4, bi + zi);
+		store(re + i + 2 * n4, T(ar - yr)), store(im + i + 2 * n4, T(ai - yi));
+		store(re + i + 3 * n4, T(br - zr)), store(im + i + 3 * n4, T(bi - zi));
+	}
 	
-	if (rx.negative()) {
-		for (; rx.negative(); delta += delta) {
-			BigInteger t = (x2 + x2 - delta + delta.square()) * (*this); 
-			x2 -= delta, rx += t;
+	// The vectorized passes over the first len butterflies
+	BIGINTEGER_TARGET_CLONES inline void fwd_pass(double* re, double* im, int n4, const double* r, int len) {
+		int i = 0;
+#ifdef __GNUC__
+		for (; i + LANES <= len; i += LANES) fwd<vec>(re, im, i, n4, r);
+#endif
+		for (; i < len; i++) fwd<double>(re, im, i, n4, r);
+	}
+	BIGINTEGER_TARGET_CLONES inline void inv_pass(double* re, double* im, int n4, const double* r, int len) {
+		int i = 0;
+#ifdef __GNUC__
+		for (; i + LANES <= len; i += LANES) inv<vec>(re, im, i, n4, r);
+#endif
+		for (; i < len; i++) inv<double>(re, im, i, n4, r);
+	}
+	BIGINTEGER_TARGET_CLONES inline void sqr(double* re, double* im, int n) {  // a[i] *= a[i]
+		int i = 0;
+#ifdef __GNUC__
+		for (; i + LANES <= n; i += LANES) {
+			vec x, y;
+			load(x, re + i), load(y, im + i);
+			store(re + i, vec(x * x - y * y)), store(im + i, vec(2.0 * x * y));
 		}
-	} else {
-		while (true) {
-			BigInteger t = (x2 + x2 + delta) * delta * (*this); 
-			if (t > rx) break; 
-			x2 += delta, rx -= t, delta += delta;
+#endif
+		for (; i < n; i++) {
+			double x = re[i], y = im[i];
+			re[i] = x * x - y * y, im[i] = 2 * x * y;
 		}
 	}
-	for (; delta.positive(); delta = delta.half()) {
-		BigInteger t = (x2 + x2 + delta) * delta * (*this); 
-		if (t <= rx) x2 += delta, rx -= t;
+	BIGINTEGER_TARGET_CLONES inline void mul(double* re, double* im, const double* bre, const double* bim, int n) {  // a[i] *= b[i]
+		int i = 0;
+#ifdef __GNUC__
+		for (; i + LANES <= n; i += LANES) {
+			vec x, y, u, v;
+			load(x, re + i), load(y, im + i), load(u, bre + i), load(v, bim + i);
+			store(re + i, vec(x * u - y * v)), store(im + i, vec(x * v + y * u));
+		}
+#endif
+		for (; i < n; i++) {
+			double x = re[i], y = im[i];
+			re[i] = x * bre[i] - y * bim[i], im[i] = x * bim[i] + y * bre[i];
+		}
 	}
-	return x2;
-}
-BigInteger BigInteger::sqrt() const {
-	if (negative()) throw NegativeRadicandError();
-	if (digits.size() <= NEWTON_SQRT_LIMIT) return sqrt_normal();
-	int n = digits.size(), n2 = (n & 1) ? n + 1 : n;
-	BigInteger res = (*this * newton_invsqrt())._move_r(n2), r = *this - res.square(), delta = 1;
-	while (true) {
-		BigInteger dr = (res + res + delta) * delta; 
-		if (dr > r) break; 
-		r -= dr, res += delta, delta += delta;
-	} 
-	for (; delta > 0; delta = delta.half()) {
-		BigInteger dr = (res + res + delta) * delta; 
-		if (dr <= r) r -= dr, res += delta;
-	} 
+	// a[i] += x[i] * b[i]
+	BIGINTEGER_TARGET_CLONES inline void mul_add(double* re, double* im, const double* xre, const double* xim, const double* bre, const double* bim, int n) {
+		int i = 0;
+#ifdef __GNUC__
+		for (; i + LANES <= n; i += LANES) {
+			vec x, y, u, v, r, t;
+			load(x, xre + i), load(y, xim + i), load(u, bre + i), load(v, bim + i), load(r, re + i), load(t, im + i);
+			store(re + i, vec(r + x * u - y * v)), store(im + i, vec(t + x * v + y * u));
+		}
+#endif
+		for (; i < n; i++) {
+			double x = xre[i], y = xim[i];
+			re[i] += x * bre[i] - y * bim[i], im[i] += x * bim[i] + y * bre[i];
+		}
+	}
+	BIGINTEGER_TARGET_CLONES inline void scale(double* a, int n, double s) {  // a[i] = a[i] * s + 0.5, ready to truncate
+		int i = 0;
+#ifdef __GNUC__
+		for (; i + LANES <= n; i += LANES) {
+			vec x;
+			load(x, a + i), store(a + i, vec(x * s + 0.5));
+		}
+#endif
+		for (; i < n; i++) a[i] = a[i] * s + 0.5;
+	}
+	
+	template <const int n> inline void fft(double* re, double* im) {
+		const int n2 = n >> 1, n4 = n >> 2;
+		const double* r = roots(lg(n));
+		if (__POOL::enabled(n2)) {  // n doubles hold n / 2 limbs, the pass and the three sub-transforms are split
+			__POOL::for_range(n4, LANES, [&](int lo, int hi) {fwd_pass(re + lo, im + lo, n4, r + lo, hi - lo);});
+			__POOL::for_each(3, [&](int i) {
+				if (i == 0) fft<n2>(re, im);
+				else fft<n4>(re + n2 + (i - 1) * n4, im + n2 + (i - 1) * n4);
+			});
+			return;
+		}
+		if (n4 >= LANES) fwd_pass(re, im, n4, r, n4);
+		else for (int i = 0; i < n4; i++) fwd<double>(re, im, i, n4, r);
+		fft<n2>(re, im), fft<n4>(re + n2, im + n2), fft<n4>(re + n2 + n4, im + n2 + n4);
+	}
+	template <> inline void fft<0>(double*, double*) {}
+	template <> inline void fft<1>(double*, double*) {}
+	template <> inline void fft<2>(double* re, double* im) {
+		double x = re[1], y = im[1];
+		re[1] = re[0] - x, im[1] = im[0] - y, re[0] += x, im[0] += y;
+	}
+	template <const int n> inline void ifft(double* re, double* im) {
+		const int n2 = n >> 1, n4 = n >> 2;
+		const double* r = roots(lg(n));
+		if (__POOL::enabled(n2)) {
+			__POOL::for_each(3, [&](int i) {
+				if (i == 0) ifft<n2>(re, im);
+				else ifft<n4>(re + n2 + (i - 1) * n4, im + n2 + (i - 1) * n4);
+			});
+			__POOL::for_range(n4, LANES, [&](int lo, int hi) {inv_pass(re + lo, im + lo, n4, r + lo, hi - lo);});
+			return;
+		}
+		ifft<n2>(re, im), ifft<n4>(re + n2, im + n2), ifft<n4>(re + n2 + n4, im + n2 + n4);
+		if (n4 >= LANES) inv_pass(re, im, n4, r, n4);
+		else for (int i = 0; i < n4; i++) inv<double>(re, im, i, n4, r);
+	}
+	template <> inline void ifft<0>(double*, double*) {}
+	template <> inline void ifft<1>(double*, double*) {}
+	template <> inline void ifft<2>(double* re, double* im) {fft<2>(re, im);}
+	inline void dft(double* re, double* im, int n) {
+		if (n <= 1) return;
+		switch (n) {
+			case 1<<2:fft<1<<2>(re, im);break;
+			case 1<<3:fft<1<<3>(re, im);break;
+			case 1<<4:fft<1<<4>(re, im);break;
+			case 1<<5:fft<1<<5>(re, im);break;
+			case 1<<6:fft<1<<6>(re, im);break;
+			case 1<<7:fft<1<<7>(re, im);break;
+			case 1<<8:fft<1<<8>(re, im);break;
+			case 1<<9:fft<1<<9>(re, im);break;
+			case 1<<10:fft<1<<10>(re, im);break;
+			case 1<<11:fft<1<<11>(re, im);break;
+			case 1<<12:fft<1<<12>(re, im);break;
+			case 1<<13:fft<1<<13>(re, im);break;
+			case 1<<14:fft<1<<14>(re, im);break;
+			case 1<<15:fft<1<<15>(re, im);break;
+			case 1<<16:fft<1<<16>(re, im);break;
+			case 1<<17:fft<1<<17>(re, im);break;
+			case 1<<18:fft<1<<18>(re, im);break;
+			case 1<<19:fft<1<<19>(re, im);break;
+			case 1<<20:fft<1<<20>(re, im);break;
+			case 1<<21:fft<1<<21>(re, im);break;
+			default:throw FFTLimitExceededError();
+		}
+	}
+	inline void idft(double* re, double* im, int n) {
+		if (n <= 1) return;
+		switch (n) {
+			case 1<<2:ifft<1<<2>(re, im);break;
+			case 1<<3:ifft<1<<3>(re, im);break;
+			case 1<<4:ifft<1<<4>(re, im);break;
+			case 1<<5:ifft<1<<5>(re, im);break;
+			case 1<<6:ifft<1<<6>(re, im);break;
+			case 1<<7:ifft<1<<7>(re, im);break;
+			case 1<<8:ifft<1<<8>(re, im);break;
+			case 1<<9:ifft<1<<9>(re, im);break;
+			case 1<<10:ifft<1<<10>(re, im);break;
+			case 1<<11:ifft<1<<11>(re, im);break;
+			case 1<<12:ifft<1<<12>(re, im);break;
+			case 1<<13:ifft<1<<13>(re, im);break;
+			case 1<<14:ifft<1<<14>(re, im);break;
+			case 1<<15:ifft<1<<15>(re, im);break;
+			case 1<<16:ifft<1<<16>(re, im);break;
+			case 1<<17:ifft<1<<17>(re, im);break;
+			case 1<<18:ifft<1<<18>(re, im);break;
+			case 1<<19:ifft<1<<19>(re, im);break;
+			case 1<<20:ifft<1<<20>(re, im);break;
+			case 1<<21:ifft<1<<21>(re, im);break;
+			default:throw FFTLimitExceededError();
+		}
+	}
+}
+
+#ifdef __SIZEOF_INT128__
+namespace __NTT {  // Exact NTT over two 62-bit primes combined by CRT, no length limit but memory
+	using u64 = uint64_t;
+	using u128 = unsigned __int128;
+	struct field {  // Montgomery arithmetic modulo p < 2^62 with R = 2^64
+		u64 p, g, pinv, r2;  // g is a primitive root, pinv = p^-1 mod R, r2 = R^2 mod p
+		field(u64 p, u64 g) : p(p), g(g), pinv(p) {
+			for (int i = 0; i < 5; i++) pinv *= 2 - p * pinv;
+			u64 r = (0 - p) % p;
+			r2 = (u128) r * r % p;
+		}
+		inline u64 reduce(u128 t) const {
+			u64 m = u64(t) * pinv, r = u64(t >> 64) - u64((u128) m * p >> 64);
+			return int64_t(r) < 0 ? r + p : r;
+		}
+		inline u64 mul(u64 a, u64 b) const {return reduce((u128) a * b);}
+		inline u64 add(u64 a, u64 b) const {return a += b, a >= p ? a - p : a;}
+		inline u64 sub(u64 a, u64 b) const {return a >= b ? a - b : a + p - b;}
+		inline u64 to(u64 a) const {return mul(a, r2);}
+		u64 pow(u64 a, u64 b) const {  // a in Montgomery form
+			u64 res = to(1);
+			for (; b; b >>= 1, a = mul(a, a)) if (b & 1) res = mul(res, a);
+			return res;
+		}
+	};
+	inline const field P[2] = {field(0x1b00000000000001ULL, 5), field(0x2280000000000001ULL, 5)};
+
+	// w_{2h}^j (or its inverse) in Montgomery form modulo P[t] for j < h = 2^k, built on first use and shared by all threads
+	inline const u64* roots(int t, bool inv, int k) {
+		static std::atomic<u64*> table[2][2][31];
+		static std::mutex lock;
+		u64* w = table[t][inv][k].load(std::memory_order_acquire);
+		if (w) return w;
+		std::lock_guard<std::mutex> guard(lock);
+		if ((w = table[t][inv][k].load(std::memory_order_relaxed))) return w;
+		const field& f = P[t];
+		int h = 1 << k;
+		u64 wn = f.pow(f.to(f.g), (f.p - 1) / (h << 1)), x = f.to(1);
+		if (inv) wn = f.pow(wn, f.p - 2);
+		w = new u64[h];
+		for (int j = 0; j < h; j++) w[j] = x, x = f.mul(x, wn);
+		return table[t][inv][k].store(w, std::memory_order_release), w;
+	}
+	inline u64* workspace(size_t n, int id) {  // Scratch arrays (id < 4) kept by each thread for reuse, not zeroed
+		static thread_local std::vector<u64> pool[4];
+		if (pool[id].size() < n) pool[id] = std::vector<u64>(n);
+		return pool[id].data();
+	}
+	inline void dif(int t, u64* a, int lim) {  // Natural order to bit-reversed
+		const field& f = P[t];
+		if (__POOL::enabled(lim)) {  // After the top level the two halves are independent transforms
+			const int h = lim >> 1;
+			const u64* w = roots(t, false, __FFT::lg(h));
+			__POOL::for_range(h, 64, [&](int lo, int hi) {
+				for (int j = lo; j < hi; j++) {
+					u64 x = a[j], y = a[j + h];
+					a[j] = f.add(x, y), a[j + h] = f.mul(f.sub(x, y), w[j]);
+				}
+			});
+			return __POOL::invoke([&] {dif(t, a, h);}, [&] {dif(t, a + h, h);});
+		}
+		for (int k = __FFT::lg(lim) - 1; k >= 0; k--) {
+			const int h = 1 << k;
+			const u64* w = roots(t, false, k);
+			for (int s = 0; s < lim; s += h << 1) {
+				for (int j = 0; j < h; j++) {
+					u64 x = a[s + j], y = a[s + j + h];
+					a[s + j] = f.add(x, y), a[s + j + h] = f.mul(f.sub(x, y), w[j]);
+				}
+			}
+		}
+	}
+	inline void dit(int t, u64* a, int lim) {  // Bit-reversed order to natural
+		const field& f = P[t];
+		if (__POOL::enabled(lim)) {
+			const int h = lim >> 1;
+			const u64* w = roots(t, true, __FFT::lg(h));
+			__POOL::invoke([&] {dit(t, a, h);}, [&] {dit(t, a + h, h);});
+			return __POOL::for_range(h, 64, [&](int lo, int hi) {
+				for (int j = lo; j < hi; j++) {
+					u64 x = a[j], y = f.mul(a[j + h], w[j]);
+					a[j] = f.add(x, y), a[j + h] = f.sub(x, y);
+				}
+			});
+		}
+		for (int k = 0; 1 << k < lim; k++) {
+			const int h = 1 << k;
+			const u64* w = roots(t, true, k);
+			for (int s = 0; s < lim; s += h << 1) {
+				for (int j = 0; j < h; j++) {
+					u64 x = a[s + j], y = f.mul(a[s + j + h], w[j]);
+					a[s + j] = f.add(x, y), a[s + j + h] = f.sub(x, y);
+				}
+			}
+		}
+	}
+
+	inline int length(int n, int m) {  // The transform length of multiply(), where the transform of b is shared when n >= 4m
+		int lim = 1;
+		while (lim < (n >= 4 * m ? 4 * m : n + m)) lim <<= 1;
+		return lim;
+	}
+	inline void transform(const digit_t* a, int n, int lim, u64* out) {  // out[t * lim, (t + 1) lim) for each prime t
+		for (int t = 0; t < 2; t++) std::fill(out + t * lim, out + (t + 1) * lim, 0), std::copy(a, a + n, out + t * lim), dif(t, out + t * lim, lim);
+	}
+	// Add the inverse transforms c0 and c1 of length lim, combined by CRT, to res[0, sz) (limbs in base), and the carry
+	// beyond. Each value must be below p0 * p1
+	template <digit_t base = BASE> inline void crt(const u64* c0, const u64* c1, int lim, int sz, digit_t* res) {
+		const field &f = P[0], &g = P[1];
+		u64 s0 = f.to(f.pow(f.to(lim), f.p - 2)), s1 = g.to(g.pow(g.to(lim), g.p - 2));  // lim^-1 * R^2, undoes the two reductions
+		u64 inv = g.pow(g.to(f.p), g.p - 2);  // p0^-1 mod p1 in Montgomery form, p0 < p1
+		u128 carry = 0;
+		for (int j = 0; j < sz; j++) {
+			u64 x = f.mul(c0[j], s0), y = g.mul(g.sub(g.mul(c1[j], s1), x), inv);
+			carry += x + (u128) f.p * y + res[j];
+			res[j] = carry % base, carry /= base;
+		}
+		for (int j = sz; carry != 0; j++) res[j] = carry % base, carry /= base;
+	}
+	
+	// Multiply a[0, n) by b[0, m) (limbs in base, BASE by default) into res[0, n + m), b == nullptr means squaring.
+	// When a is much longer, b is transformed once and shared by blocks of a cut to fit the transform. tb may give
+	// that transform of b from transform(b, m, length(n, m))
+	template <digit_t base = BASE> inline void multiply(const digit_t* a, int n, const digit_t* b, int m, digit_t* res, const u64* tb = nullptr) {
+		int lim = b ? length(n, m) : length(n, n);
+		int k = b ? lim - m : n;  // The length of each block of a
+		bool par = __POOL::enabled(lim);  // Then the primes run in parallel on arrays of their own, as forking must not hold a workspace
+		std::vector<u64> own(par ? lim * 4 : 0);
+		auto both = [par](const std::function<void(int)>& g) {par ? __POOL::for_each(2, g) : (g(0), g(1));};
+		u64 *fb[2], *c[2];
+		for (int t = 0; t < 2; t++) {
+			c[t] = par ? own.data() + t * lim : workspace(lim, t);
+			fb[t] = tb ? const_cast<u64*>(tb) + t * lim : par ? own.data() + (t + 2) * lim : workspace(lim, t + 2);
+		}
+		if (b && !tb) both([&](int t) {std::fill(fb[t], fb[t] + lim, 0), std::copy(b, b + m, fb[t]), dif(t, fb[t], lim);});
+		std::fill(res, res + n + m, 0);
+		for (int i = 0; i < n; i += k) {
+			int len = std::min(k, n - i);
+			both([&](int t) {
+				u64* x = c[t];
+				std::fill(x, x + lim, 0), std::copy(a + i, a + i + len, x), dif(t, x, lim);
+				const u64* y = b ? fb[t] : x;
+				for (int j = 0; j < lim; j++) x[j] = P[t].mul(x[j], y[j]);
+				dit(t, x, lim);
+			});
+			crt<base>(c[0], c[1], lim, len + m, res + i);  // The sum so far fits, so nothing carries past len + m
+		}
+	}
+	// res[0, lim) and the carry beyond = a * b wrapped around modulo x^lim - 1, for n, m <= lim
+	inline void cyclic(const digit_t* a, int n, const digit_t* b, int m, int lim, digit_t* res) {
+		bool par = __POOL::enabled(lim);
+		std::vector<u64> own(par ? lim * 4 : 0);
+		u64 *x[2], *y[2];
+		for (int t = 0; t < 2; t++) {
+			x[t] = par ? own.data() + t * lim : workspace(lim, t);
+			y[t] = par ? own.data() + (t + 2) * lim : workspace(lim, t + 2);
+		}
+		auto run = [&](int t) {
+			std::fill(x[t], x[t] + lim, 0), std::copy(a, a + n, x[t]), dif(t, x[t], lim);
+			std::fill(y[t], y[t] + lim, 0), std::copy(b, b + m, y[t]), dif(t, y[t], lim);
+			for (int j = 0; j < lim; j++) x[t][j] = P[t].mul(x[t][j], y[t][j]);
+			dit(t, x[t], lim);
+		};
+		par ? __POOL::for_each(2, run) : (run(0), run(1));
+		std::fill(res, res + lim, 0), crt(x[0], x[1], lim, lim, res);
+	}
+}
+#endif  // __SIZEOF_INT128__
+
+BigInteger BigInteger::fft_mul(const BigInteger& a, const BigInteger& b) {
+	int n = a.digits.size(), m = b.digits.size();
+	if (n < m) return fft_mul(b, a);
+	if (n >= 4 * m) return fft_mul_unbalanced(a, b);
+	int least = (n + m) << 1, lim = 1;
+	while (lim < least) lim <<= 1;
+	
+	std::vector<double> own;  // The transform forks in parallel mode, which must not hold the thread's workspace
+	bool par = __POOL::enabled(lim >> 1);
+	if (par) own.resize(lim << 1);
+	double *re = par ? own.data() : __FFT::workspace(lim, 0), *im = par ? own.data() + lim : __FFT::workspace(lim, 1);
+	std::fill(re, re + lim, 0.0), std::fill(im, im + lim, 0.0);
+	__FFT::split(a.digits.data(), n, re), __FFT::split(b.digits.data(), m, im);
+	__FFT::dft(re, im, lim);
+	__FFT::sqr(re, im, lim);
+	__FFT::idft(re, im, lim);
+	__FFT::scale(im, (n + m) << 1, 0.5 / lim);
+	
+	limb_vector res(n + m);
+	__FFT::join(im, n + m, res.data());
+	return res;
+}
+// Blocks of a share the transform of b, by default with lim >= 8m for n >= 4m. With a transform tb of b of length
+// lim already at hand, as from Multiplicand, any n works
+BigInteger BigInteger::fft_mul_unbalanced(const BigInteger& a, const BigInteger& b, int lim, const double* tb) {
+	int n = a.digits.size(), m = b.digits.size();
+	if (lim == 0) for (lim = 1; lim < m << 3; lim <<= 1);
+	int k = (lim >> 1) - m, cnt = (n + 2 * k - 1) / (2 * k);  // Two blocks of k limbs of a fill one transform
+	
+	bool par = __POOL::enabled(n + m);  // Then each transform has its own arrays, as forking must not hold a workspace
+	std::vector<double> own(par && !tb ? lim << 1 : 0);
+	const double *bre = tb, *bim = tb + lim;
+	if (!tb) {
+		double *re = par ? own.data() : __FFT::workspace(lim, 2), *im = par ? own.data() + lim : __FFT::workspace(lim, 3);
+		std::fill(re, re + lim, 0.0), std::fill(im, im + lim, 0.0);
+		__FFT::split(b.digits.data(), m, re), __FFT::dft(re, im, lim);
+		bre = re, bim = im;
+	}
+	limb_vector res(n + m);
+	std::mutex lock;
+	auto block = [&](int i, double* re, double* im, digit_t* blk) {  // Blocks i * 2k and i * 2k + k
+		std::fill(re, re + lim, 0.0), std::fill(im, im + lim, 0.0);
+		for (int t = 0, s = i * 2 * k; t < 2 && s < n; t++, s += k) __FFT::split(a.digits.data() + s, std::min(k, n - s), t ? im : re);
+		__FFT::dft(re, im, lim);
+		__FFT::mul(re, im, bre, bim, lim);
+		__FFT::idft(re, im, lim);
+		for (int t = 0, s = i * 2 * k; t < 2 && s < n; t++, s += k) {  // The real part holds the first block, the imaginary part the second
+			int sz = std::min(k, n - s) + m;
+			double* x = t ? im : re;
+			__FFT::scale(x, sz << 1, 1.0 / lim), __FFT::join(x, sz, blk);
+			if (par) {std::lock_guard<std::mutex> guard(lock); __MUL::add_to(res.data() + s, n + m - s, blk, sz);}
+			else __MUL::add_to(res.data() + s, n + m - s, blk, sz);
+		}
+	};
+	if (par) {
+		__POOL::for_range(cnt, 1, [&](int lo, int hi) {
+			std::vector<double> x(lim << 1);
+			std::vector<digit_t> blk(k + m);
+			for (int i = lo; i < hi; i++) block(i, x.data(), x.data() + lim, blk.data());
+		});
+	} else {
+		std::vector<digit_t> blk(k + m);
+		for (int i = 0; i < cnt; i++) block(i, __FFT::workspace(lim, 0), __FFT::workspace(lim, 1), blk.data());
+	}
+	return res;
+}
+BigInteger BigInteger::ntt_mul(const BigInteger& a, const BigInteger& b) {
+#ifdef __SIZEOF_INT128__
+	int n = a.digits.size(), m = b.digits.size();
+	if (n < m) return ntt_mul(b, a);
+	limb_vector res(n + m);
+	__NTT::multiply(a.digits.data(), n, &a == &b ? nullptr : b.digits.data(), m, res.data());
+	return res;
+#else
+	return fft_mul(a, b);
+#endif  // __SIZEOF_INT128__
+}
+
+// Products modulo BASE^L - 1, for the results known to be small but for the top limbs, which wrap around onto them
+int BigInteger::cyclic_length(int n) {  // The least L >= n with a cheap wrap-around product, a power of 2 from FFT_LIMIT
+	if (n < FFT_LIMIT) return n;
+	int L = 1;
+	while (L < n) L <<= 1;
+	return L;
+}
+BigInteger BigInteger::fold(const BigInteger& a, int L) {  // |a| mod (BASE^L - 1) in [0, BASE^L)
+	int n = a.digits.size();
+	BigInteger res = a.low(L);
+	for (int i = L; i < n; i += L) res += BigInteger(limb_vector(a.digits.begin() + i, a.digits.begin() + std::min(n, i + L)));
+	while ((int) res.digits.size() > L) res = res.low(L) + res._move_r(L);
+	return res;
+}
+BigInteger BigInteger::balance(BigInteger a, int L) {  // The value of a mod (BASE^L - 1) nearest to 0, for |a| < BASE^L
+	if ((int) a.digits.size() < L) return a;
+	BigInteger m = BigInteger(1)._move_l(L) - 1, t = a + a;
+	if (t > m) a -= m;
+	else if (-t > m) a += m;
+	return a;
+}
+// a * b mod (BASE^L - 1) in [0, BASE^L) for a, b < BASE^L and L from cyclic_length(). One transform of L limbs
+// (2L digits for FFT) holds the whole product wrapped around, where a * b needs n + m
+BigInteger BigInteger::mul_cyclic(const BigInteger& a, const BigInteger& b, int L) {
+	int n = a.digits.size(), m = b.digits.size();
+	if (std::min(n, m) < FFT_LIMIT || n + m <= L) return fold(a * b, L);
+	limb_vector res(L + 3);
+#ifdef __SIZEOF_INT128__
+	if (L >= NTT_LIMIT) return __NTT::cyclic(a.digits.data(), n, b.digits.data(), m, L, res.data()), fold(BigInteger(std::move(res)), L);
+#endif  // __SIZEOF_INT128__
+	int lim = L << 1;
+	std::vector<double> own;  // As in fft_mul()
+	bool par = __POOL::enabled(L);
+	if (par) own.resize(lim << 1);
+	double *re = par ? own.data() : __FFT::workspace(lim, 0), *im = par ? own.data() + lim : __FFT::workspace(lim, 1);
+	std::fill(re, re + lim, 0.0), std::fill(im, im + lim, 0.0);
+	__FFT::split(a.digits.data(), n, re), __FFT::split(b.digits.data(), m, im);
+	__FFT::dft(re, im, lim);
+	__FFT::sqr(re, im, lim);
+	__FFT::idft(re, im, lim);
+	__FFT::scale(im, lim, 0.5 / lim);
+	__FFT::join(im, L, res.data());
+	return fold(BigInteger(std::move(res)), L);
+}
+
+BigInteger BigInteger::mul_abs(const BigInteger& a, const BigInteger& b) {  // |a| * |b|, choosing the algorithm by size
+	int n = a.digits.size(), m = b.digits.size();
+	if (n < m) return mul_abs(b, a);
+	if (m >= FFT_LIMIT || (n >= 4 * m && m >= UNBALANCED_FFT_LIMIT)) {  // The longer operand is cut in blocks when n >= 4m
+		return (n >= 4 * m ? 4 * m : n + m) >= NTT_LIMIT ? ntt_mul(a, b) : fft_mul(a, b);
+	}
+	limb_vector res(n + m);
+	bool par = __POOL::enabled(n + m);  // Then the kernels fork, which must not hold the thread's scratch
+	std::vector<digit_t> own(par ? 6 * (n + m) + 256 : 0);
+	__MUL::multiply(a.digits.data(), n, b.digits.data(), m, res.data(), par ? own.data() : __MUL::workspace(6 * (n + m) + 256));
+	return res;
+}
+BigInteger BigInteger::sqr_abs(const BigInteger& a) {
+	int n = a.digits.size();
+	if (n >= FFT_LIMIT) return n << 1 >= NTT_LIMIT ? ntt_mul(a, a) : fft_mul(a, a);
+	limb_vector res(n << 1);
+	bool par = __POOL::enabled(n << 1);
+	std::vector<digit_t> own(par ? 12 * n + 256 : 0);
+	__MUL::square(a.digits.data(), n, res.data(), par ? own.data() : __MUL::workspace(12 * n + 256));
 	return res;
 }
 
+BigInteger BigInteger::operator* (const BigInteger& x) const & {
+	if (zero() || x.zero()) return BigInteger();
+	BigInteger res = mul_abs(*this, x);
+	return res.flag = !(flag ^ x.flag), res;
+}
+BigInteger BigInteger::operator* (const BigInteger& x) && {return std::move(*this *= x);}
+BigInteger BigInteger::operator* (BigInteger&& x) const & {return std::move(x *= *this);}
+BigInteger BigInteger::operator* (BigInteger&& x) && {return std::move(*this *= x);}
+BigInteger& BigInteger::operator*= (const BigInteger& x) {
+	return *this = *this * x;
+}
+BigInteger BigInteger::square() const {  // Calculate the square, faster than a * a
+	if (zero()) return BigInteger();
+	return sqr_abs(*this);
+}
+
+BigInteger& BigInteger::mul_word(uword_t x, bool neg) {  // this *= (neg ? -x : x)
+	if (x == 0 || zero()) return *this = 0;
+	int n = digits.size();
+	if (x < (uword_t) BASE) {  // A single limb, in place
+		digit_t v = x, carry = 0;
+		for (int i = 0; i < n; i++) carry += digits[i] * v, digits[i] = carry % BASE, carry /= BASE;
+		if (carry != 0) digits.emplace_back(carry);
+	} else {  // Up to 5 limbs, by rows into the thread's scratch
+		digit_t y[5], *p = __MUL::workspace(n + 5);
+		int m = split(x, y);
+		__MUL::basecase(digits.data(), n, y, m, p);
+		digits.assign(p, p + n + m), trim();
+	}
+	flag ^= neg;
+	return *this;
+}
+
+BigInteger& BigInteger::add_mag(const digit_t* x, int m, bool neg) {  // this += (neg ? -x : x) for the limbs x[0, m)
+	while (m > 1 && x[m - 1] == 0) m--;
+	int n = digits.size();
+	if (zero() || negative() == neg) {  // |this| += x
+		if (n < m) digits.resize(m), n = m;
+		digit_t* r = digits.data();
+		if (__MUL::add(r, r, n, x, m)) digits.emplace_back(1);
+		flag = !neg;
+	} else if (__MUL::compare(static_cast<const limb_vector&>(digits).data(), n, x, m) >= 0) {
+		digit_t* r = digits.data();
+		__MUL::sub(r, r, n, x, m);
+	} else {  // x - |this| with the sign of x
+		digit_t* r = (digits.resize(m), digits.data());
+		__MUL::sub(r, x, m, r, n);
+		flag = !neg;
+	}
+	trim(), flag |= zero();
+	return *this;
+}
+// this += (neg ? -|a| : |a|) * |b|. A factor of one limb is multiplied and added in one pass, other products that do
+// not fork are built in the thread's scratch, and only the sum is kept in the storage of this
+void BigInteger::add_mul(const BigInteger& a, const BigInteger& b, bool neg) {
+	int n = a.digits.size(), m = b.digits.size();
+	if (n < m) return add_mul(b, a, neg);
+	if (a.zero() || b.zero()) return;
+	if (this == &a || this == &b) {
+		BigInteger t = mul_abs(a, b);
+		return void(add_mag(t.digits.data(), t.digits.size(), neg));
+	}
+	if (m == 1) {
+		int len = std::max((int) digits.size(), n) + 1;
+		digit_t* r = (digits.resize(len), digits.data());
+		if (zero() || negative() == neg) {
+			digit_t carry = __MUL::addmul_1(r, a.digits.data(), n, b.digits[0]);
+			for (int i = n; carry != 0; i++) carry += r[i], r[i] = carry % BASE, carry /= BASE;
+			flag = !neg;
+		} else {
+			digit_t borrow = __MUL::submul_1(r, a.digits.data(), n, b.digits[0]);
+			for (int i = n; i < len && borrow != 0; i++) r[i] -= borrow, borrow = r[i] < 0, r[i] += borrow * BASE;
+			if (borrow) {  // Went below 0 by BASE^len, negate
+				for (int i = 0; i < len; i++) r[i] = BASE - 1 - r[i];
+				for (int i = 0; ++r[i] == BASE; i++) r[i] = 0;
+				flag ^= 1;
+			}
+		}
+		return void((trim(), flag |= zero()));
+	}
+	if (m >= FFT_LIMIT || (n >= 4 * m && m >= UNBALANCED_FFT_LIMIT) || __POOL::enabled(n + m)) {
+		BigInteger t = mul_abs(a, b);
+		return void(add_mag(t.digits.data(), t.digits.size(), neg));
+	}
+	digit_t* p = __MUL::workspace(7 * (n + m) + 256);
+	__MUL::multiply(a.digits.data(), n, b.digits.data(), m, p, p + n + m);
+	add_mag(p, n + m, neg);
+}
+
+void mul(BigInteger& dst, const BigInteger& a, const BigInteger& b) {
+	int n = a.digits.size(), m = b.digits.size();
+	if (n < m) return mul(dst, b, a);
+	if (&dst == &a || &dst == &b || a.zero() || b.zero() || m >= FFT_LIMIT || (n >= 4 * m && m >= UNBALANCED_FFT_LIMIT) || __POOL::enabled(n + m)) {
+		return void(dst = a * b);
+	}
+	dst.digits.resize(n + m);
+	__MUL::multiply(a.digits.data(), n, b.digits.data(), m, dst.digits.data(), __MUL::workspace(6 * (n + m) + 256));
+	dst.flag = a.flag == b.flag, dst.trim();
+}
+void addmul(BigInteger& acc, const BigInteger& a, const BigInteger& b) {acc.add_mul(a, b, a.flag != b.flag);}
+void submul(BigInteger& acc, const BigInteger& a, const BigInteger& b) {acc.add_mul(a, b, a.flag == b.flag);}
+void addmul_ui(BigInteger& acc, const BigInteger& a, uint64_t x) {
+	BigInteger y;
+	y.digits.clear();
+	do {y.digits.emplace_back(x % BASE), x /= BASE;} while (x);
+	acc.add_mul(a, y, a.negative());
+}
+void submul_ui(BigInteger& acc, const BigInteger& a, uint64_t x) {  // -(-acc + a * x), negated in place
+	acc.flag ^= !acc.zero(), addmul_ui(acc, a, x), acc.flag ^= !acc.zero();
+}
+
+BigInteger BigInteger::half() const {
+	BigInteger res = *this;
+	for (int i = digits.size() - 1; i >= 0; i--) {
+		if ((res[i] & 1) && i > 0) res.digits[i - 1] += BASE;
+		res.digits[i] >>= 1;
+	} 
+	return res.trim();
+}
+// |this| /= x in place, returns |this| % x. The running remainder times BASE fits in 64 bits for x < 2^63 / BASE and
+// in 128 bits for x < 2^64. Larger x has at most 5 limbs, so its long division is linear as well
+uword_t BigInteger::div_word(uword_t x) {
+	if (x == 0) throw ZeroDivisionError();
+	digit_t* d = digits.data();
+	uword_t r = 0;
+	if (x <= (uword_t) (LLONG_MAX / BASE)) {
+		digit_t v = x, cur = 0;
+		for (int i = digits.size() - 1; i >= 0; i--) cur = cur * BASE + d[i], d[i] = cur / v, cur %= v;
+		r = cur;
+	}
+#ifdef __SIZEOF_INT128__
+	else if (x >> 64 == 0) {
+		uint64_t v = x;
+		for (int i = digits.size() - 1; i >= 0; i--) r = r * BASE + d[i], d[i] = r / v, r -= (uword_t) d[i] * v;
+	}
+#endif  // __SIZEOF_INT128__
+	else {
+		BigInteger b;
+		auto qr = abs().divmod(b.set_word(x, false));
+		digits = std::move(qr.first.digits);
+		for (int i = qr.second.digits.size() - 1; i >= 0; i--) r = r * BASE + qr.second.digits[i];
+	}
+	trim(), flag |= zero();
+	return r;
+}
+uword_t BigInteger::mod_word(uword_t x) const {  // |this| % x, the same as div_word without the quotient
+	if (x == 0) throw ZeroDivisionError();
+	uword_t r = 0;
+	if (x <= (uword_t) (LLONG_MAX / BASE)) {
+		digit_t v = x, cur = 0;
+		for (int i = digits.size() - 1; i >= 0; i--) cur = (cur * BASE + digits[i]) % v;
+		r = cur;
+	}
+#ifdef __SIZEOF_INT128__
+	else if (x >> 64 == 0) {
+		uint64_t v = x;
+		for (int i = digits.size() - 1; i >= 0; i--) r = (r * BASE + digits[i]) % v;
+	}
+#endif  // __SIZEOF_INT128__
+	else r = BigInteger(*this).div_word(x);
+	return r;
+}
+uint64_t BigInteger::mod_ui(uint64_t x) const {  // this mod x in [0, x)
+	uint64_t r = mod_word(x);
+	return negative() && r != 0 ? x - r : r;
+}
+
+// Within 3 of BASE^n / x. From y = BASE^N / x to about half the precision, y + y * e / BASE^N with the error
+// e = BASE^N - x * y doubles it. Only the top p + 3 limbs of x count and e is below 3x, so x * y is wrapped around
+// modulo BASE^L - 1 for the low limbs, and only the top limbs of e are multiplied by y
+BigInteger BigInteger::newton_inv(int n) const {  // Solve BASE^n / x
+	if (zero()) throw ZeroDivisionError();
+	int sz = digits.size(), p = n - sz;
+	if (sz > p + 3) return _move_r(sz - p - 3).newton_inv(2 * p + 3);
+	if (std::min(sz, p) <= NEWTON_DIV_MIN_LEVEL) {
+		limb_vector a(n + 1);
+		a[n] = 1;
+		return BigInteger(std::move(a)).divmod(*this).first;
+	}
+	int l = p - (p >> 1) - 2, N = n - l, L = cyclic_length(sz + 1), d = std::max(0, sz - l - 2);
+	BigInteger y = newton_inv(N), e = balance(BigInteger(1)._move_l(N % L) - mul_cyclic(*this, fold(y, L), L), L);
+	BigInteger c = (y * e._move_r(d))._move_r(2 * N - n - d);
+	return e.negative() ? y._move_l(l) - c : y._move_l(l) + c;
+}
+std::pair<BigInteger, BigInteger> BigInteger::div_basecase(const BigInteger& a, const BigInteger& b) {  // b normalized
+	int n = a.digits.size(), m = b.digits.size();
+	limb_vector r(n + 1), q(n - m + 1);
+	std::copy(a.digits.begin(), a.digits.end(), r.begin());
+	__DIV::basecase(r.data(), n, b.digits.data(), m, q.data());
+	r.resize(m);
+	return std::make_pair(BigInteger(std::move(q)), BigInteger(std::move(r)));
+}
+// Burnikel-Ziegler: a < b * BASE^n with b of n limbs normalized, two halves of the quotient by div3n2n each
+std::pair<BigInteger, BigInteger> BigInteger::div2n1n(const BigInteger& a, const BigInteger& b, int n) {
+	if (n < BZ_DIV_LIMIT) return a < b ? std::make_pair(BigInteger(), a) : div_basecase(a, b);
+	if (n & 1) {  // Pad to an even length
+		auto qr = div2n1n(a._move_l(1), b._move_l(1), n + 1);
+		return std::make_pair(std::move(qr.first), qr.second._move_r(1));
+	}
+	int h = n >> 1;
+	BigInteger b1 = b._move_r(h), b2 = b.low(h);
+	auto qr1 = div3n2n(a._move_r(n), a._move_r(h).low(h), b, b1, b2, h);
+	auto qr2 = div3n2n(qr1.second, a.low(h), b, b1, b2, h);
+	return std::make_pair(qr1.first._move_l(h) + qr2.first, std::move(qr2.second));
+}
+// [a12, a3] / [b1, b2] with n-limb parts, a12 < b * BASE^n, the estimate from a12 / b1 is at most 2 too large
+std::pair<BigInteger, BigInteger> BigInteger::div3n2n(const BigInteger& a12, const BigInteger& a3, const BigInteger& b, 
+	const BigInteger& b1, const BigInteger& b2, int n) {
+	std::pair<BigInteger, BigInteger> qr;
+	if (a12._move_r(n) == b1) qr.first = BigInteger(1)._move_l(n) - 1, qr.second = a12 - b1._move_l(n) + b1;
+	else qr = div2n1n(a12, b1, n);
+	qr.second = qr.second._move_l(n) + a3 - qr.first * b2;
+	while (qr.second.negative()) qr.first -= 1, qr.second += b;
+	return qr;
+}
+std::pair<BigInteger, BigInteger> BigInteger::div_bz(const BigInteger& a, const BigInteger& b) {  // b normalized
+	int n = a.digits.size(), m = b.digits.size();
+	limb_vector q(n);
+	BigInteger r;
+	for (int i = (n - 1) / m * m; i >= 0; i -= m) {  // Long division in base BASE^m
+		auto qr = div2n1n(r._move_l(m) + BigInteger(limb_vector(a.digits.begin() + i, a.digits.begin() + std::min(n, i + m))), b, m);
+		std::copy(qr.first.digits.begin(), qr.first.digits.end(), q.begin() + i), r = std::move(qr.second);
+	}
+	return std::make_pair(BigInteger(std::move(q)), std::move(r));
+}
+std::pair<BigInteger, BigInteger> BigInteger::divmod(const BigInteger& x) const {
+	if (x.zero()) throw ZeroDivisionError();
+	BigInteger a = abs(), b = x.abs(), q, r;
+	int n = a.digits.size(), m = b.digits.size();
+	if (a < b) r = std::move(a);
+	else if (m == 1) r.set_word(a.div_word(b.digits[0]), false), q = std::move(a);
+	else if (std::min(m, n - m) > NEWTON_DIV_LIMIT) {  // q from the top limbs of a is within 2, so r = a - q * b wraps around
+		int k = n - m + 2, L = cyclic_length(m + 1);
+		q = (a._move_r(m - 1) * b.newton_inv(m + k))._move_r(k + 1);
+		r = balance(fold(a, L) - mul_cyclic(fold(q, L), b, L), L);
+		while (r.negative()) q -= 1, r += b;
+		while (r >= b) q += 1, r -= b;
+	} else {
+		int32_t t = BASE / (b.digits.back() + 1);  // Normalize so that the top limb of b is at least BASE / 2
+		if (t > 1) a *= t, b *= t;
+		std::tie(q, r) = m < BZ_DIV_LIMIT ? div_basecase(a, b) : div_bz(a, b);
+		if (t > 1) r /= t;
+	}
+	q.flag = q.zero() || flag == x.flag, r.flag = r.zero() || flag;
+	return std::make_pair(q, r);
+}
+
+BigInteger BigInteger::hensel_inv(int n) const {  // Solve this^-1 mod BASE^n, where the lowest limb is coprime to 10
+	if (n <= HENSEL_DIV_LIMIT) {
+		limb_vector a(n), q(n);
+		a[0] = 1, __DIV::hensel(a.data(), n, digits.data(), std::min(n, (int) digits.size()), q.data());
+		return BigInteger(std::move(q));
+	}
+	int h = (n + 1) >> 1;
+	BigInteger x = hensel_inv(h), e = (low(n) * x).low(n)._move_r(h);  // this * x = 1 + e * BASE^h
+	x -= (x.low(n - h) * e).low(n - h)._move_l(h);
+	return x.negative() ? x + BigInteger(1)._move_l(n) : x;
+}
+BigInteger BigInteger::divexact(const BigInteger& x) const {
+	if (x.zero()) throw ZeroDivisionError();
+	BigInteger a = abs(), b = x.abs(), q;
+	int z = 0;
+	while (b.digits[z] == 0) z++;
+	if (z != 0) a = a._move_r(z), b = b._move_r(z);
+	for (int i = 0; b.digits[0] % 2 == 0 || b.digits[0] % 5 == 0; i++) {  // Divide out the factors 2 and 5 of the lowest limb
+		if (i == 4) return *this / x;  // A high power of 2 or 5, which comes out only 8 at a time
+		digit_t c = 1, d = b.digits[0];
+		for (int j = 0; j < 8 && d % 2 == 0; j++) d /= 2, c *= 2;
+		for (int j = 0; j < 8 && d % 5 == 0; j++) d /= 5, c *= 5;
+		a /= c, b /= c;
+	}
+	int n = a.digits.size(), m = b.digits.size(), k = n - m + 1;
+	if (k <= 0) return BigInteger();
+	if (std::min(k, 2 * m) <= HENSEL_DIV_LIMIT) {
+		limb_vector r(a.digits.begin(), a.digits.begin() + k), t(k);
+		__DIV::hensel(r.data(), k, b.digits.data(), std::min(k, m), t.data());
+		q = BigInteger(std::move(t));
+	} else q = (a.low(k) * b.hensel_inv(k)).low(k);
+	q.flag = q.zero() || flag == x.flag;
+	return q;
+}
+
+BigInteger BigInteger::operator/ (const BigInteger& x) const & {return divmod(x).first;}
+BigInteger BigInteger::operator/ (const BigInteger& x) && {return std::move(*this /= x);}
+BigInteger& BigInteger::operator/= (const BigInteger& x) {
+	return *this = divmod(x).first;
+}
+BigInteger BigInteger::operator% (const BigInteger& x) const & {return divmod(x).second;}
+BigInteger BigInteger::operator% (const BigInteger& x) && {return std::move(*this %= x);}
+BigInteger& BigInteger::operator%= (const BigInteger& x) {
+	return *this = divmod(x).second;
+}
+
+BigInteger BigInteger::pow(int64_t b) const {
+	BigInteger a = *this, res = 1;
+	for (; b; b >>= 1) {
+		if (b & 1) res *= a;
+		a = a.square();
+	} return res;
+}
+
+BigInteger BigInteger::sqrt_normal() const {
+	BigInteger x0 = BigInteger(BASE)._move_l((digits.size() + 2) >> 1);
+	BigInteger x = (x0 + *this / x0).half();
+	while (x < x0) std::swap(x, x0), x = (x0 + *this / x0).half();
+	return x0;
+}
+// Karatsuba square root (Zimmermann): a = a3 * B^3 + a2 * B^2 + a1 * B + a0 with B = BASE^k and a3 >= B, where from
+// s, r of a3 * B + a2, the quotient of r * B + a1 by 2s extends s to the root of a, at most 1 too large
+std::pair<BigInteger, BigInteger> BigInteger::sqrtrem(const BigInteger& a) {
+	int n = a.digits.size(), k = (n - 1) >> 2;
+	if (n <= SQRT_LIMIT) {
+		BigInteger s = a.sqrt_normal();
+		return std::make_pair(s, a - s.square());
+	}
+	auto sr = sqrtrem(a._move_r(2 * k));
+	auto qu = (sr.second._move_l(k) + a._move_r(k).low(k)).divmod(sr.first + sr.first);
+	BigInteger s = sr.first._move_l(k) + qu.first, r = qu.second._move_l(k) + a.low(k) - qu.first.square();
+	if (r.negative()) r += s + s - 1, s -= 1;
+	return std::make_pair(s, r);
+}
+BigInteger BigInteger::sqrt() const {
+	if (negative()) throw NegativeRadicandError();
+	if (zero()) return BigInteger();
+	return digits.size() <= SQRT_LIMIT ? sqrt_normal() : sqrtrem(*this).first;
+}
+
 BigInteger BigInteger::root(const int64_t& m) const {
 	if (m <= 0 || (m % 2 == 0 && negative())) throw NegativeRadicandError();
 	if (m == 1 || zero()) return *this;
@@ -781,60 +1980,1290 @@ BigInteger BigInteger::root(const int64_t& m) const {
 	return res.digits[0] = l, res.trim();
 }
 
-BigInteger BigInteger::gcd(BigInteger b) const {
-	BigInteger a = *this;
-	if (a < b) std::swap(a, b); 
-	if (b == 0) return a;
-	int64_t t = 0;
-	while (!a.mod2() && !b.mod2()) a = a.half(), b = b.half(), t++;
-	while (b.positive()) {
-		if (!a.mod2()) a = a.half(); 
-		else if (!b.mod2()) b = b.half(); 
-		else a -= b;
-		if (a < b) std::swap(a, b);
-	} 
-	return a * BigInteger(2).pow(t);
+struct BigInteger::matrix {  // The transform (x, y) -> (a x + b y, c x + d y) of a run of Euclid steps, det = +-1
+	BigInteger a = 1, b, c, d = 1;
+	void apply(BigInteger& x, BigInteger& y) const {
+		BigInteger t = a * x + b * y;
+		y = c * x + d * y, x = std::move(t);
+	}
+};
+
+void BigInteger::combine(BigInteger& u, BigInteger& v, digit_t A, digit_t B, digit_t C, digit_t D) {  // (A u + B v, C u + D v)
+	if (!u.zero() && !v.zero() && u.flag == v.flag) {
+		BigInteger t = u * (int32_t) A + v * (int32_t) B;
+		v = u * (int32_t) C + v * (int32_t) D, u = std::move(t);
+		return;
+	}
+	// Cofactors alternate in sign, so both terms of each row share theirs and only the magnitudes add up
+	bool nu = A != 0 && !u.zero() ? (A < 0) != u.negative() : (B < 0) != v.negative();
+	bool nv = C != 0 && !u.zero() ? (C < 0) != u.negative() : (D < 0) != v.negative();
+	A = std::abs(A), B = std::abs(B), C = std::abs(C), D = std::abs(D);
+	int n = std::max(u.digits.size(), v.digits.size());
+	u.digits.resize(n), v.digits.resize(n);
+	digit_t cu = 0, cv = 0;
+	for (int i = 0; i < n; i++) {
+		cu += A * u.digits[i] + B * v.digits[i], cv += C * u.digits[i] + D * v.digits[i];
+		u.digits[i] = cu % BASE, v.digits[i] = cv % BASE, cu /= BASE, cv /= BASE;
+	}
+	for (; cu != 0; cu /= BASE) u.digits.emplace_back(cu % BASE);
+	for (; cv != 0; cv /= BASE) v.digits.emplace_back(cv % BASE);
+	u.trim(), v.trim();
+	u.flag = !nu || u.zero(), v.flag = !nv || v.zero();
+}
+bool BigInteger::lehmer(BigInteger& x, BigInteger& y, matrix* M) {  // x >= y > 0, false if no quotient is certain
+	constexpr digit_t LIM = 1e9;  // Bounds the cofactors, so A x_i + B y_i stays in digit_t
+	int n = x.digits.size();
+	if (n < 2) return false;
+	digit_t xh = x[n - 1] * BASE + x[n - 2], yh = y[n - 1] * BASE + y[n - 2];
+	digit_t A = 1, B = 0, C = 0, D = 1;
+	while (yh + C > 0 && yh + D > 0) {  // Knuth's algorithm L, the quotient is taken only if both bounds agree
+		digit_t q = (xh + A) / (yh + C);
+		if (q != (xh + B) / (yh + D) || q > LIM || q * std::abs(C) + std::abs(A) > LIM || q * std::abs(D) + std::abs(B) > LIM) break;
+		digit_t t = A - q * C; A = C, C = t;
+		t = B - q * D, B = D, D = t;
+		t = xh - q * yh, xh = yh, yh = t;
+	}
+	if (B == 0) return false;
+	y.digits.resize(n);
+	digit_t cx = 0, cy = 0;
+	for (int i = 0; i < n; i++) {
+		digit_t u = A * x.digits[i] + B * y.digits[i] + cx, v = C * x.digits[i] + D * y.digits[i] + cy;
+		cx = u / BASE, u %= BASE, cy = v / BASE, v %= BASE;
+		if (u < 0) u += BASE, cx--;
+		if (v < 0) v += BASE, cy--;
+		x.digits[i] = u, y.digits[i] = v;
+	}
+	x.trim(), y.trim();
+	if (M) combine(M->a, M->c, A, B, C, D), combine(M->b, M->d, A, B, C, D);
+	return true;
+}
+void BigInteger::euclid(BigInteger& x, BigInteger& y, matrix* M) {  // (x, y) -> (y, x mod y)
+	auto qr = x.divmod(y);
+	x = std::move(y), y = std::move(qr.second);
+	if (M) {
+		BigInteger c = M->a - qr.first * M->c, d = M->b - qr.first * M->d;
+		M->a = std::move(M->c), M->b = std::move(M->d), M->c = std::move(c), M->d = std::move(d);
+	}
+}
+void BigInteger::hgcd(BigInteger& x, BigInteger& y, int s, matrix* M) {  // x >= y >= 0, Euclid steps until y < BASE^s
+	while ((int) y.digits.size() > s) {
+		// The steps on the top n - p limbs are those of x and y while they stay above half of that length.
+		// Far from s, go halfway on the top n - s limbs, otherwise all the way on the top 2(n - s)
+		int n = x.digits.size(), p = 3 * (n - s) <= n ? 2 * s - n : s;
+		matrix L;
+		if (n >= HGCD_LIMIT) {
+			BigInteger x1 = x._move_r(p), y1 = y._move_r(p);
+			hgcd(x1, y1, ((n - p) >> 1) + 1, &L);
+		}
+		if (L.b.zero() && L.c.zero()) {
+			if (!lehmer(x, y, M)) euclid(x, y, M);
+			continue;
+		}
+		L.apply(x, y);
+		if (x.negative()) x.flag = true, L.a = -L.a, L.b = -L.b;  // Repair an overshoot, keeping det = +-1
+		if (y.negative()) y.flag = true, L.c = -L.c, L.d = -L.d;
+		if (x < y) std::swap(x, y), std::swap(L.a, L.c), std::swap(L.b, L.d);
+		if (M) L.apply(M->a, M->c), L.apply(M->b, M->d);
+	}
+}
+BigInteger BigInteger::gcd_abs(BigInteger a, BigInteger b, matrix* M) {  // a, b >= 0, M maps (a, b) to (gcd, 0)
+	if (a < b) {
+		std::swap(a, b);
+		if (M) std::swap(M->a, M->c), std::swap(M->b, M->d);
+	}
+	while (!b.zero()) {
+		int n = a.digits.size();
+		if (n <= 2 && !M) {
+			digit_t x = a[1] * BASE + a[0], y = b[1] * BASE + b[0];
+			while (y != 0) x %= y, std::swap(x, y);
+			return x;
+		}
+		if (n >= HGCD_LIMIT && (int) b.digits.size() > (n >> 1)) hgcd(a, b, n >> 1, M);
+		else if (!lehmer(a, b, M)) euclid(a, b, M);
+	}
+	return a;
+}
+
+BigInteger BigInteger::gcd(const BigInteger& b) const {return gcd_abs(abs(), b.abs(), nullptr);}
+std::tuple<BigInteger, BigInteger, BigInteger> BigInteger::gcdext(const BigInteger& b) const {  // g = s * a + t * b
+	matrix M;
+	BigInteger g = gcd_abs(abs(), b.abs(), &M);
+	if (negative()) M.a = -M.a;
+	if (b.negative()) M.b = -M.b;
+	return std::make_tuple(std::move(g), std::move(M.a), std::move(M.b));
+}
+BigInteger BigInteger::modinv(const BigInteger& m) const {  // In [0, |m|)
+	if (m.zero()) throw ZeroDivisionError();
+	BigInteger g, s, t;
+	std::tie(g, s, t) = gcdext(m);
+	if (g != 1) throw NotInvertibleError();
+	s %= m;
+	return s.negative() ? s + m.abs() : s;
 }
 BigInteger BigInteger::lcm(const BigInteger& x) const {
-	return *this / gcd(x) * x;
+	if (zero() || x.zero()) return BigInteger();
+	return abs().divexact(gcd(x)) * x.abs();
 }
 
-BigInteger BigInteger::operator<< (const int64_t& x) const {return *this * BigInteger(2).pow(x);}
-BigInteger BigInteger::operator>> (const int64_t& x) const {return *this / BigInteger(2).pow(x);}
-BigInteger& BigInteger::operator<<= (const int64_t& x) {return *this *= BigInteger(2).pow(x);}
-BigInteger& BigInteger::operator>>= (const int64_t& x) {return *this /= BigInteger(2).pow(x);}
+namespace __RADIX {  // Divide-and-conquer radix conversion between BASE limbs and 2^32 limbs, both little-endian
+	constexpr digit_t BIN = 1LL << 32;
+	
+	inline int length(const digit_t* a, int n) {  // The length without leading zeros
+		while (n > 0 && a[n - 1] == 0) n--;
+		return n;
+	}
+	inline void mul(const digit_t* a, int n, const digit_t* b, int m, digit_t* r) {  // r[0, n + m) = a * b in 2^32 limbs
+#ifdef __SIZEOF_INT128__
+		if (std::min(n, m) >= BINARY_NTT_LIMIT) return n >= m ? __NTT::multiply<BIN>(a, n, b, m, r) : __NTT::multiply<BIN>(b, m, a, n, r);
+#endif  // __SIZEOF_INT128__
+		std::fill(r, r + n + m, 0);
+		for (int i = 0; i < n; i++) {
+			uint64_t carry = 0;
+			for (int j = 0; j < m; j++) carry += (uint64_t) a[i] * b[j] + r[i + j], r[i + j] = carry & (BIN - 1), carry >>= 32;
+			r[i + m] = carry;
+		}
+	}
+	
+	// BASE^(2^j) in 2^32 limbs and 2^(32 * 2^j) as BigInteger, cached per thread
+	inline const std::vector<digit_t>& bin_pow(int j) {
+		static thread_local std::deque<std::vector<digit_t>> p{{BASE}};
+		while ((int) p.size() <= j) {
+			const std::vector<digit_t>& x = p.back();
+			std::vector<digit_t> y(x.size() * 2);
+			mul(x.data(), x.size(), x.data(), x.size(), y.data());
+			y.resize(length(y.data(), y.size())), p.emplace_back(std::move(y));
+		}
+		return p[j];
+	}
+	inline const BigInteger& dec_pow(int j) {
+		static thread_local std::deque<BigInteger> p{BigInteger(BIN)};
+		while ((int) p.size() <= j) p.emplace_back(p.back().square());
+		return p[j];
+	}
+	
+	inline std::vector<digit_t> to_bin(const digit_t* d, int n) {  // BASE limbs d[0, n) to 2^32 limbs, without leading zeros
+		if (n <= RADIX_LIMIT) {  // Horner's rule
+			std::vector<digit_t> r;
+			for (int i = n - 1; i >= 0; i--) {
+				uint64_t carry = d[i];
+				for (digit_t& w : r) carry += (uint64_t) w * BASE, w = carry & (BIN - 1), carry >>= 32;
+				if (carry) r.emplace_back(carry);
+			}
+			return r;
+		}
+		int j = 0;
+		while (2 << j < n) j++;  // Split at 2^j < n <= 2^(j + 1) limbs
+		std::vector<digit_t> hi = to_bin(d + (1 << j), n - (1 << j)), lo = to_bin(d, 1 << j);
+		const std::vector<digit_t>& p = bin_pow(j);
+		std::vector<digit_t> r(hi.size() + p.size());
+		mul(hi.data(), hi.size(), p.data(), p.size(), r.data());
+		digit_t carry = 0;
+		for (size_t i = 0; i < lo.size() || carry; i++) r[i] += (i < lo.size() ? lo[i] : 0) + carry, carry = r[i] >> 32, r[i] &= BIN - 1;
+		return r.resize(length(r.data(), r.size())), r;
+	}
+	inline limb_vector to_dec_basecase(const digit_t* c, int n) {  // 2^32 limbs c[0, n) to BASE limbs
+		limb_vector r;
+		for (int i = n - 1; i >= 0; i--) {
+			digit_t carry = c[i];
+			for (digit_t& d : r) carry += d << 32, d = carry % BASE, carry /= BASE;
+			while (carry) r.emplace_back(carry % BASE), carry /= BASE;
+		}
+		if (r.empty()) r.emplace_back(0);
+		return r;
+	}
+}
 
-BigInteger __helper(const BigInteger& x, const BigInteger& y, const std::function<bool(bool, bool)>& op) {
-	std::vector<bool> a = x.to_binary(), b = y.to_binary();
-	int n = a.size(), m = b.size(), lim = std::max(n, m);
-	std::vector<bool> res(lim);
-	for (int i = 0; i < lim; ++i) res[i] = op(i < n ? a[i] : 0, i < m ? b[i] : 0);
+struct BinaryInteger {  // Two's complement integer on 64-bit limbs, shifts and bitwise operations are linear
+protected:
+	std::vector<uint64_t> words;  // Little-endian, the highest bit of the last word is the sign
+	BinaryInteger(const std::vector<uint64_t>& v) : words(v) {trim();}
+	
+	BinaryInteger& trim() {  // Remove the words that only repeat the sign
+		while (words.size() > 1U && words.back() == fill() && (words.end()[-2] >> 63) == (words.back() & 1)) words.pop_back();
+		return *this;
+	}
+	uint64_t fill() const {return negative() ? ~0ULL : 0;}
+	uint64_t operator[] (size_t x) const {return x < words.size() ? words[x] : fill();}  // Sign-extended
+	template <typename Op> static BinaryInteger bitwise(const BinaryInteger&, const BinaryInteger&, Op);
+	static BigInteger to_dec(const digit_t*, int);
+	friend struct BigInteger;
+	template <int> friend struct FixedBigInteger;
+public:
+	BinaryInteger() : words(1, 0) {}
+	BinaryInteger(const int64_t& x) : words(1, x) {}
+	BinaryInteger(const BigInteger&);
+	BinaryInteger(const std::string& s) : BinaryInteger(BigInteger(s)) {}
+	
+	BigInteger to_bigint() const;
+	std::string to_string() const {return to_bigint().to_string();}
+	friend std::ostream& operator<< (std::ostream& out, const BinaryInteger& x) {return out << x.to_bigint();}
+	
+	bool zero() const {return words.size() == 1 && words[0] == 0;}
+	bool negative() const {return words.back() >> 63;}
+	int _word_len() const {return words.size();}
+	int64_t bit_length() const;
+	bool test(int64_t) const;
+	
+	int compare(const BinaryInteger&) const;
+	bool operator== (const BinaryInteger& x) const {return words == x.words;}
+#if __cplusplus >= 202002L
+	auto operator<=> (const BinaryInteger& x) const {return compare(x);}
+#else
+	bool operator< (const BinaryInteger& x) const {return compare(x) < 0;}
+	bool operator> (const BinaryInteger& x) const {return compare(x) > 0;}
+	bool operator!= (const BinaryInteger& x) const {return words != x.words;}
+	bool operator<= (const BinaryInteger& x) const {return compare(x) <= 0;}
+	bool operator>= (const BinaryInteger& x) const {return compare(x) >= 0;}
+#endif   // __cplusplus >= 202002L
+	
+	BinaryInteger operator- () const;
+	BinaryInteger operator~ () const;
+	
+	BinaryInteger operator<< (int64_t) const;
+	BinaryInteger operator>> (int64_t) const;
+	BinaryInteger& operator<<= (const int64_t& x) {return *this = *this << x;}
+	BinaryInteger& operator>>= (const int64_t& x) {return *this = *this >> x;}
+	
+	BinaryInteger operator& (const BinaryInteger&) const;
+	BinaryInteger operator| (const BinaryInteger&) const;
+	BinaryInteger operator^ (const BinaryInteger&) const;
+	BinaryInteger& operator&= (const BinaryInteger& x) {return *this = *this & x;}
+	BinaryInteger& operator|= (const BinaryInteger& x) {return *this = *this | x;}
+	BinaryInteger& operator^= (const BinaryInteger& x) {return *this = *this ^ x;}
+};
+
+BinaryInteger::BinaryInteger(const BigInteger& x) {
+	std::vector<digit_t> c = __RADIX::to_bin(x.digits.data(), x.digits.size());
+	c.resize((c.size() + 2) & ~(size_t) 1);  // Room for the sign, padded to whole words
+	words.resize(c.size() >> 1);
+	for (size_t i = 0; i < words.size(); i++) words[i] = c[i << 1] | (uint64_t) c[i << 1 | 1] << 32;
+	if (x.negative()) *this = -*this;
+	trim();
+}
+BigInteger BinaryInteger::to_dec(const digit_t* c, int n) {  // 2^32 limbs c[0, n) to BigInteger
+	if (n <= RADIX_LIMIT) return __RADIX::to_dec_basecase(c, n);
+	int j = 0;
+	while (2 << j < n) j++;  // Split at 2^j < n <= 2^(j + 1) limbs
+	return to_dec(c + (1 << j), n - (1 << j)) * __RADIX::dec_pow(j) + to_dec(c, 1 << j);
+}
+BigInteger BinaryInteger::to_bigint() const {
+	if (negative()) return -(-*this).to_bigint();
+	std::vector<digit_t> c(words.size() << 1);
+	for (size_t i = 0; i < words.size(); i++) c[i << 1] = words[i] & (__RADIX::BIN - 1), c[i << 1 | 1] = words[i] >> 32;
+	return to_dec(c.data(), __RADIX::length(c.data(), c.size()));
+}
+
+int64_t BinaryInteger::bit_length() const {  // The length without the sign, as Python's int.bit_length() for x >= 0
+	uint64_t top = words.back() ^ fill();
+	int64_t res = (words.size() - 1) * 64;
+	for (; top; top >>= 1) res++;
+	return res;
+}
+bool BinaryInteger::test(int64_t x) const {return (*this)[x >> 6] >> (x & 63) & 1;}
+
+int BinaryInteger::compare(const BinaryInteger& x) const {
+	if (negative() != x.negative()) return negative() ? -1 : 1;
+	int sgn = negative() ? -1 : 1;
+	if (words.size() != x.words.size()) return words.size() > x.words.size() ? sgn : -sgn;
+	for (int i = words.size() - 1; i >= 0; i--) {
+		if (words[i] != x.words[i]) return words[i] > x.words[i] ? 1 : -1;
+	} return 0;
+}
+
+BinaryInteger BinaryInteger::operator- () const {  // ~x + 1
+	std::vector<uint64_t> res(words);
+	res.emplace_back(fill());
+	bool carry = true;
+	for (uint64_t& w : res) w = ~w + carry, carry = carry && w == 0;
+	return res;
+}
+BinaryInteger BinaryInteger::operator~ () const {
+	std::vector<uint64_t> res(words);
+	for (uint64_t& w : res) w = ~w;
+	return res;
+}
+
+BinaryInteger BinaryInteger::operator<< (int64_t x) const {  // Limb moves plus a funnel shift
+	if (x < 0) return *this >> -x;
+	if (zero()) return *this;
+	int64_t q = x >> 6, r = x & 63, n = words.size();
+	std::vector<uint64_t> res(n + q + 1);
+	for (int64_t i = 0; i <= n; i++) {
+		res[i + q] = (*this)[i] << r | (r && i ? words[i - 1] >> (64 - r) : 0);
+	}
+	return res;
+}
+BinaryInteger BinaryInteger::operator>> (int64_t x) const {  // Arithmetic shift, rounds towards negative infinity
+	if (x < 0) return *this << -x;
+	int64_t q = x >> 6, r = x & 63, n = words.size();
+	if (q >= n) return std::vector<uint64_t>(1, fill());
+	std::vector<uint64_t> res(n - q);
+	for (int64_t i = 0; i < n - q; i++) {
+		res[i] = words[i + q] >> r | (r ? (*this)[i + q + 1] << (64 - r) : 0);
+	}
+	return res;
+}
+
+template <typename Op> BinaryInteger BinaryInteger::bitwise(const BinaryInteger& a, const BinaryInteger& b, Op op) {
+	size_t n = std::max(a.words.size(), b.words.size());
+	std::vector<uint64_t> res(n);
+	for (size_t i = 0; i < n; i++) res[i] = op(a[i], b[i]);
+	return res;
+}
+BinaryInteger BinaryInteger::operator& (const BinaryInteger& x) const {
+	return bitwise(*this, x, [](uint64_t a, uint64_t b) -> uint64_t {return a & b;});
+}
+BinaryInteger BinaryInteger::operator| (const BinaryInteger& x) const {
+	return bitwise(*this, x, [](uint64_t a, uint64_t b) -> uint64_t {return a | b;});
+}
+BinaryInteger BinaryInteger::operator^ (const BinaryInteger& x) const {
+	return bitwise(*this, x, [](uint64_t a, uint64_t b) -> uint64_t {return a ^ b;});
+}
+
+// Binary interchange formats, converted through BinaryInteger
+std::vector<bool> BigInteger::to_binary() const {  // Two's complement, big-endian with the sign bit first
+	BinaryInteger x(*this);
+	int64_t n = x.bit_length() + 1;
+	std::vector<bool> res(n);
+	for (int64_t i = 0; i < n; i++) res[i] = x.test(n - 1 - i);
+	return res;
+}
+BigInteger& BigInteger::operator= (const std::vector<bool>& v) {
+	if (v.empty()) return *this = 0;
+	size_t n = v.size();
+	std::vector<uint64_t> w(n / 64 + 1, v[0] ? ~0ULL : 0);  // Sign-extended
+	for (size_t i = 0; i < n; i++) {
+		if (v[n - 1 - i]) w[i >> 6] |= 1ULL << (i & 63);
+		else w[i >> 6] &= ~(1ULL << (i & 63));
+	}
+	return *this = BinaryInteger(w).to_bigint();
+}
+std::vector<uint8_t> BigInteger::to_bytes(bool big_endian, bool is_signed) const {  // The shortest form, as Python's int.to_bytes()
+	if (!flag && !is_signed) throw NegativeUnsignedError();
+	BinaryInteger x(*this);
+	size_t n = is_signed ? x.bit_length() / 8 + 1 : std::max<int64_t>(1, (x.bit_length() + 7) / 8);
+	std::vector<uint8_t> res(n);
+	for (size_t i = 0; i < n; i++) res[i] = x[i >> 3] >> ((i & 7) << 3);
+	if (big_endian) std::reverse(res.begin(), res.end());
+	return res;
+}
+BigInteger BigInteger::from_bytes(const uint8_t* p, size_t n, bool big_endian, bool is_signed) {
+	std::vector<uint64_t> w(n / 8 + 1);  // One more word for the sign
+	for (size_t i = 0; i < n; i++) w[i >> 3] |= (uint64_t) p[big_endian ? n - 1 - i : i] << ((i & 7) << 3);
+	if (is_signed && n && p[big_endian ? 0 : n - 1] >> 7) {
+		for (size_t i = n; i < w.size() * 8; i++) w[i >> 3] |= 0xffULL << ((i & 7) << 3);
+	}
+	return BinaryInteger(w).to_bigint();
+}
+std::string BigInteger::to_hex() const {  // Lowercase, '-' for negative values, as Python's format(x, 'x')
+	if (zero()) return "0";
+	BinaryInteger x(abs());
+	std::string res;
+	for (int64_t i = (x.bit_length() + 3) / 4 - 1; i >= 0; i--) res += "0123456789abcdef"[x[i >> 4] >> ((i & 15) << 2) & 15];
+	return flag ? res : '-' + res;
+}
+BigInteger BigInteger::from_hex(const std::string& s) {  // Leading '-' signs and "0x" are allowed, digits in either case
+	size_t i = 0, n = s.size();
+	bool neg = false;
+	while (i < n && s[i] == '-') neg ^= 1, i++;
+	if (i + 1 < n && s[i] == '0' && (s[i + 1] | 32) == 'x') i += 2;
+	std::vector<uint64_t> w((n - i) / 16 + 1);
+	for (size_t j = 0; j < n - i; j++) {
+		char c = s[n - 1 - j];
+		uint64_t v = c >= '0' && c <= '9' ? c - '0' : 'a' <= (c | 32) && (c | 32) <= 'f' ? (c | 32) - 'a' + 10 : 16;
+		if (v > 15) throw std::invalid_argument("Invalid hexadecimal digit");
+		w[j >> 4] |= v << ((j & 15) << 2);
+	}
+	BigInteger res = BinaryInteger(w).to_bigint();
+	return neg ? -res : res;
+}
+
+// The shifts and bitwise operations of BigInteger follow two's complement
+BigInteger BigInteger::operator<< (const int64_t& x) const {
+	if (x < 0) return x == INT64_MIN ? *this >> INT64_MAX >> 1 : *this >> -x;
+	if (x < 27) return *this * (1LL << x);
+	if (x / 27 < (int64_t) digits.size()) return *this * BigInteger(2).pow(x);  // The conversions would cost more
+	return (BinaryInteger(*this) << x).to_bigint();
+}
+BigInteger BigInteger::operator>> (const int64_t& x) const {
+	if (x < 0) return x == INT64_MIN ? *this << INT64_MAX << 1 : *this << -x;
+	if (!flag) return ~(~*this >> x);  // Rounds towards negative infinity
+	if (x < 27) return *this / (1LL << x);
+	return (BinaryInteger(*this) >> x).to_bigint();
+}
+BigInteger& BigInteger::operator<<= (const int64_t& x) {return *this = *this << x;}
+BigInteger& BigInteger::operator>>= (const int64_t& x) {return *this = *this >> x;}
+
+BigInteger BigInteger::operator& (const BigInteger& x) const {return (BinaryInteger(*this) & x).to_bigint();}
+BigInteger BigInteger::operator| (const BigInteger& x) const {return (BinaryInteger(*this) | x).to_bigint();}
+BigInteger BigInteger::operator^ (const BigInteger& x) const {return (BinaryInteger(*this) ^ x).to_bigint();}
+BigInteger& BigInteger::operator&= (const BigInteger& x) {return *this = *this & x;}
+BigInteger& BigInteger::operator|= (const BigInteger& x) {return *this = *this | x;}
+BigInteger& BigInteger::operator^= (const BigInteger& x) {return *this = *this ^ x;}
+
+#ifdef __GNUC__
+#define BIGINTEGER_UNROLL _Pragma("GCC unroll 16")  // Small fixed sizes are unrolled completely, larger ones by 16
+#else
+#define BIGINTEGER_UNROLL
+#endif
+// An unsigned integer modulo 2^Bits on inline 64-bit limbs, for bounded sizes such as 256, 512 or 4096 bits. The limb
+// count is a constant, so the constexpr kernels below are specialized for it by the compiler and nothing allocates
+template <int Bits> struct FixedBigInteger {
+	static_assert(Bits > 0, "FixedBigInteger needs at least one bit");
+	static constexpr int LIMBS = (Bits + 63) / 64;
+	static constexpr uint64_t TOP = Bits % 64 ? (1ULL << Bits % 64) - 1 : ~0ULL;  // The bits of the last limb
+protected:
+	uint64_t w[LIMBS];  // Little-endian
+	
+	constexpr FixedBigInteger& wrap() {return w[LIMBS - 1] &= TOP, *this;}  // Reduce modulo 2^Bits
+	static constexpr uint64_t mul_wide(uint64_t a, uint64_t b, uint64_t& lo) {  // Returns the high word of a * b
+#ifdef __SIZEOF_INT128__
+		unsigned __int128 p = (unsigned __int128) a * b;
+		return lo = p, p >> 64;
+#else
+		uint64_t a0 = a & 0xffffffff, a1 = a >> 32, b0 = b & 0xffffffff, b1 = b >> 32;
+		uint64_t p0 = a0 * b0, p1 = a0 * b1, p2 = a1 * b0, mid = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+		return lo = mid << 32 | (p0 & 0xffffffff), a1 * b1 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif  // __SIZEOF_INT128__
+	}
+	constexpr void mul_add(uint64_t x, uint64_t y) {  // this = this * x + y
+		BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) {
+			uint64_t lo = 0, hi = mul_wide(w[i], x, lo);
+			w[i] = lo + y, y = hi + (w[i] < y);
+		}
+	}
+	static constexpr void divmod(const FixedBigInteger&, const FixedBigInteger&, FixedBigInteger&, FixedBigInteger&);
+	constexpr int trailing_zeros() const;
+	static constexpr FixedBigInteger mul_mod(const FixedBigInteger& a, const FixedBigInteger& b, const FixedBigInteger& m) {
+		using Wide = FixedBigInteger<2 * Bits>;  // The full product
+		return FixedBigInteger(Wide(a) * Wide(b) % Wide(m));
+	}
+public:
+	constexpr FixedBigInteger() : w() {}
+	template <typename T, typename std::enable_if<is_word<T>::value, int>::type = 0> constexpr FixedBigInteger(T x) : w() {
+		uword_t u = x;  // Sign-extended, so a negative x is taken modulo 2^Bits
+		BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) w[i] = i < (int) sizeof(uword_t) / 8 ? uint64_t(u >> 32 * i >> 32 * i) : x < T(0) ? ~0ULL : 0;
+		wrap();
+	}
+	constexpr FixedBigInteger(const char*);
+	FixedBigInteger(const std::string& s) : FixedBigInteger(s.c_str()) {}
+	explicit FixedBigInteger(const BigInteger&);
+	template <int B> explicit constexpr FixedBigInteger(const FixedBigInteger<B>& x) : w() {
+		for (int i = 0; i < LIMBS && i < x.LIMBS; i++) w[i] = x.limbs()[i];
+		wrap();
+	}
+	
+	BigInteger to_bigint() const;
+	std::string to_string() const {return to_bigint().to_string();}
+	friend std::ostream& operator<< (std::ostream& out, const FixedBigInteger& x) {return out << x.to_bigint();}
+	
+	constexpr const uint64_t* limbs() const {return w;}
+	constexpr bool zero() const {
+		BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) if (w[i]) return false;
+		return true;
+	}
+	constexpr int bit_length() const;
+	constexpr bool test(int x) const {return x >= 0 && x < Bits && (w[x >> 6] >> (x & 63) & 1);}
+	
+	constexpr int compare(const FixedBigInteger&) const;
+	constexpr bool operator== (const FixedBigInteger& x) const {return compare(x) == 0;}
+#if __cplusplus >= 202002L
+	constexpr auto operator<=> (const FixedBigInteger& x) const {return compare(x);}
+#else
+	constexpr bool operator< (const FixedBigInteger& x) const {return compare(x) < 0;}
+	constexpr bool operator> (const FixedBigInteger& x) const {return compare(x) > 0;}
+	constexpr bool operator!= (const FixedBigInteger& x) const {return compare(x) != 0;}
+	constexpr bool operator<= (const FixedBigInteger& x) const {return compare(x) <= 0;}
+	constexpr bool operator>= (const FixedBigInteger& x) const {return compare(x) >= 0;}
+#endif   // __cplusplus >= 202002L
+	
+	constexpr FixedBigInteger operator- () const {return FixedBigInteger() -= *this;}
+	constexpr FixedBigInteger operator~ () const;
+	
+	constexpr FixedBigInteger& operator+= (const FixedBigInteger&);
+	constexpr FixedBigInteger operator+ (const FixedBigInteger& x) const {return FixedBigInteger(*this) += x;}
+	constexpr FixedBigInteger& operator++ () {return *this += 1;}
+	constexpr FixedBigInteger operator++ (int) {FixedBigInteger t = *this; return ++*this, t;}
+	constexpr FixedBigInteger& operator-= (const FixedBigInteger&);
+	constexpr FixedBigInteger operator- (const FixedBigInteger& x) const {return FixedBigInteger(*this) -= x;}
+	constexpr FixedBigInteger& operator-- () {return *this -= 1;}
+	constexpr FixedBigInteger operator-- (int) {FixedBigInteger t = *this; return --*this, t;}
+	constexpr FixedBigInteger& operator*= (const FixedBigInteger&);
+	constexpr FixedBigInteger operator* (const FixedBigInteger& x) const {return FixedBigInteger(*this) *= x;}
+	
+	constexpr std::pair<FixedBigInteger, FixedBigInteger> divmod(const FixedBigInteger& x) const {
+		FixedBigInteger q, r;
+		return divmod(*this, x, q, r), std::pair<FixedBigInteger, FixedBigInteger>(q, r);
+	}
+	constexpr FixedBigInteger operator/ (const FixedBigInteger& x) const {return divmod(x).first;}
+	constexpr FixedBigInteger operator% (const FixedBigInteger& x) const {return divmod(x).second;}
+	constexpr FixedBigInteger& operator/= (const FixedBigInteger& x) {return *this = *this / x;}
+	constexpr FixedBigInteger& operator%= (const FixedBigInteger& x) {return *this = *this % x;}
+	
+	constexpr FixedBigInteger pow(const FixedBigInteger&) const;
+	constexpr FixedBigInteger pow(const FixedBigInteger&, const FixedBigInteger&) const;
+	constexpr FixedBigInteger sqrt() const;
+	constexpr FixedBigInteger gcd(const FixedBigInteger&) const;
+	constexpr FixedBigInteger modinv(const FixedBigInteger&) const;
+	
+	constexpr FixedBigInteger operator<< (int64_t) const;
+	constexpr FixedBigInteger operator>> (int64_t) const;
+	constexpr FixedBigInteger& operator<<= (const int64_t& x) {return *this = *this << x;}
+	constexpr FixedBigInteger& operator>>= (const int64_t& x) {return *this = *this >> x;}
+	
+	constexpr FixedBigInteger& operator&= (const FixedBigInteger& x) {
+		BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) w[i] &= x.w[i];
+		return *this;
+	}
+	constexpr FixedBigInteger& operator|= (const FixedBigInteger& x) {
+		BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) w[i] |= x.w[i];
+		return *this;
+	}
+	constexpr FixedBigInteger& operator^= (const FixedBigInteger& x) {
+		BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) w[i] ^= x.w[i];
+		return *this;
+	}
+	constexpr FixedBigInteger operator& (const FixedBigInteger& x) const {return FixedBigInteger(*this) &= x;}
+	constexpr FixedBigInteger operator| (const FixedBigInteger& x) const {return FixedBigInteger(*this) |= x;}
+	constexpr FixedBigInteger operator^ (const FixedBigInteger& x) const {return FixedBigInteger(*this) ^= x;}
+};
+
+template <int Bits> constexpr FixedBigInteger<Bits>::FixedBigInteger(const char* s) : w() {  // The decimal string s modulo 2^Bits
+	bool neg = false;
+	for (; *s == '-'; s++) neg ^= 1;
+	while (*s) {  // 18 digits per pass
+		uint64_t x = 0, scale = 1;
+		for (; *s && scale < 1000000000000000000ULL; s++, scale *= 10) {
+			if (*s < '0' || *s > '9') throw std::invalid_argument("Invalid decimal digit");
+			x = x * 10 + (*s - '0');
+		}
+		mul_add(scale, x);
+	}
+	wrap();
+	if (neg) *this = -*this;
+}
+template <int Bits> FixedBigInteger<Bits>::FixedBigInteger(const BigInteger& x) : w() {  // x modulo 2^Bits
+	std::vector<digit_t> c = __RADIX::to_bin(x.digits.data(), x.digits.size());
+	for (int i = 0; i < (int) c.size() && i < 2 * LIMBS; i++) w[i >> 1] |= (uint64_t) c[i] << (i & 1 ? 32 : 0);
+	wrap();
+	if (x.negative()) *this = -*this;
+}
+template <int Bits> BigInteger FixedBigInteger<Bits>::to_bigint() const {
+	digit_t c[2 * LIMBS] = {};
+	for (int i = 0; i < LIMBS; i++) c[i << 1] = w[i] & (__RADIX::BIN - 1), c[i << 1 | 1] = w[i] >> 32;
+	return BinaryInteger::to_dec(c, __RADIX::length(c, 2 * LIMBS));
+}
+
+template <int Bits> constexpr int FixedBigInteger<Bits>::bit_length() const {
+	for (int i = LIMBS - 1; i >= 0; i--) {
+		if (!w[i]) continue;
+		int res = i * 64;
+		for (uint64_t top = w[i]; top; top >>= 1) res++;
+		return res;
+	} return 0;
+}
+template <int Bits> constexpr int FixedBigInteger<Bits>::compare(const FixedBigInteger& x) const {
+	BIGINTEGER_UNROLL for (int i = LIMBS - 1; i >= 0; i--) {
+		if (w[i] != x.w[i]) return w[i] > x.w[i] ? 1 : -1;
+	} return 0;
+}
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::operator~ () const {
+	FixedBigInteger res;
+	BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) res.w[i] = ~w[i];
+	return res.wrap();
+}
+
+template <int Bits> constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator+= (const FixedBigInteger& x) {
+	uint64_t carry = 0;
+	BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) {
+		uint64_t s = w[i] + carry;
+		carry = (s < carry) + ((w[i] = s + x.w[i]) < s);
+	}
+	return wrap();
+}
+template <int Bits> constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator-= (const FixedBigInteger& x) {
+	uint64_t borrow = 0;
+	BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) {
+		uint64_t d = w[i] - x.w[i], b = w[i] < x.w[i];
+		w[i] = d - borrow, borrow = b + (d < borrow);
+	}
+	return wrap();
+}
+template <int Bits> constexpr FixedBigInteger<Bits>& FixedBigInteger<Bits>::operator*= (const FixedBigInteger& x) {  // The low LIMBS limbs of the schoolbook product
+	uint64_t r[LIMBS] = {};
+	BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) {
+		uint64_t carry = 0;
+		BIGINTEGER_UNROLL for (int j = 0; i + j < LIMBS; j++) {
+			uint64_t lo = 0, hi = mul_wide(w[i], x.w[j], lo);
+			lo += carry, hi += lo < carry;
+			r[i + j] += lo, carry = hi + (r[i + j] < lo);
+		}
+	}
+	BIGINTEGER_UNROLL for (int i = 0; i < LIMBS; i++) w[i] = r[i];
+	return wrap();
+}
+// Knuth's algorithm D on the 32-bit halves of the limbs, so that every step fits in 64 bits
+template <int Bits> constexpr void FixedBigInteger<Bits>::divmod(const FixedBigInteger& a, const FixedBigInteger& b, FixedBigInteger& q, FixedBigInteger& r) {
+	constexpr int H = 2 * LIMBS;
+	uint32_t u[H + 1] = {}, v[H] = {}, d[H] = {};
+	for (int i = 0; i < LIMBS; i++) u[i << 1] = a.w[i], u[i << 1 | 1] = a.w[i] >> 32, v[i << 1] = b.w[i], v[i << 1 | 1] = b.w[i] >> 32;
+	int m = H, n = H, s = 0;
+	while (n > 0 && v[n - 1] == 0) n--;
+	while (m > 0 && u[m - 1] == 0) m--;
+	if (n == 0) throw ZeroDivisionError();
+	if (m < n) {
+		q = FixedBigInteger(), r = a;
+		return;
+	}
+	q = r = FixedBigInteger();
+	if (n == 1) {  // Short division
+		uint64_t rem = 0;
+		for (int i = m - 1; i >= 0; i--) rem = rem << 32 | u[i], d[i] = rem / v[0], rem %= v[0];
+		r.w[0] = rem;
+	} else {
+		while (!(v[n - 1] << s >> 31)) s++;  // Normalize so that the top half of v has its highest bit set
+		for (int i = n - 1; i >= 0; i--) v[i] = v[i] << s | (s && i ? v[i - 1] >> (32 - s) : 0);
+		for (int i = m; i >= 0; i--) u[i] = u[i] << s | (s && i ? u[i - 1] >> (32 - s) : 0);
+		for (int j = m - n; j >= 0; j--) {
+			uint64_t num = (uint64_t) u[j + n] << 32 | u[j + n - 1], qhat = num / v[n - 1], rhat = num % v[n - 1];
+			while (qhat >> 32 || qhat * v[n - 2] > (rhat << 32 | u[j + n - 2])) {  // At most two corrections
+				qhat--, rhat += v[n - 1];
+				if (rhat >> 32) break;
+			}
+			int64_t k = 0, t = 0;
+			for (int i = 0; i < n; i++) {  // u[j, j + n] -= qhat * v
+				uint64_t p = qhat * v[i];
+				t = (int64_t) u[i + j] - k - (int64_t) (p & 0xffffffff);
+				u[i + j] = t, k = (int64_t) (p >> 32) - (t >> 32);
+			}
+			t = (int64_t) u[j + n] - k, u[j + n] = t;
+			if (t < 0) {  // qhat was one too large, add v back
+				qhat--, k = 0;
+				for (int i = 0; i < n; i++) t = (int64_t) u[i + j] + v[i] + k, u[i + j] = t, k = t >> 32;
+				u[j + n] += k;
+			}
+			d[j] = qhat;
+		}
+		for (int i = 0; i < n; i++) {
+			uint64_t x = u[i] >> s | (s ? (uint64_t) u[i + 1] << (32 - s) & 0xffffffff : 0);
+			r.w[i >> 1] |= x << (i & 1 ? 32 : 0);
+		}
+	}
+	for (int i = 0; i < H; i++) q.w[i >> 1] |= (uint64_t) d[i] << (i & 1 ? 32 : 0);
+}
+
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::operator<< (int64_t x) const {
+	if (x < 0) return *this >> -x;
+	FixedBigInteger res;
+	int64_t q = x >> 6, r = x & 63;
+	for (int64_t i = LIMBS - 1; i >= q; i--) res.w[i] = w[i - q] << r | (r && i > q ? w[i - q - 1] >> (64 - r) : 0);
+	return res.wrap();
+}
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::operator>> (int64_t x) const {
+	if (x < 0) return *this << -x;
+	FixedBigInteger res;
+	int64_t q = x >> 6, r = x & 63;
+	for (int64_t i = 0; i + q < LIMBS; i++) res.w[i] = w[i + q] >> r | (r && i + q + 1 < LIMBS ? w[i + q + 1] << (64 - r) : 0);
+	return res;
+}
+
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::pow(const FixedBigInteger& e) const {  // Wraps around as *
+	FixedBigInteger res = 1;
+	for (int i = e.bit_length() - 1; i >= 0; i--) {
+		res *= res;
+		if (e.test(i)) res *= *this;
+	}
+	return res;
+}
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::pow(const FixedBigInteger& e, const FixedBigInteger& m) const {
+	FixedBigInteger a = *this % m, res = FixedBigInteger(1) % m;  // Left-to-right square-and-multiply, each product reduced at twice the width
+	for (int i = e.bit_length() - 1; i >= 0; i--) {
+		res = mul_mod(res, res, m);
+		if (e.test(i)) res = mul_mod(res, a, m);
+	}
 	return res;
 }
-BigInteger BigInteger::operator& (const BigInteger& x) const {
-	return __helper(*this, x, [](bool a, bool b) -> bool {return a & b;});
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::sqrt() const {  // Newton's iteration down from above
+	if (bit_length() < 2) return *this;
+	FixedBigInteger x = FixedBigInteger(1) << (bit_length() + 1) / 2;
+	for (;;) {  // floor((x + q) / 2) without wrapping at the top bit
+		FixedBigInteger q = *this / x, y = (x >> 1) + (q >> 1) + (x & q & 1);
+		if (!(y < x)) return x;
+		x = y;
+	}
+}
+template <int Bits> constexpr int FixedBigInteger<Bits>::trailing_zeros() const {
+	for (int i = 0; i < LIMBS; i++) {
+		if (!w[i]) continue;
+		int res = i * 64;
+		for (uint64_t low = w[i]; !(low & 1); low >>= 1) res++;
+		return res;
+	} return Bits;
+}
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::gcd(const FixedBigInteger& x) const {  // Binary GCD
+	if (zero() || x.zero()) return *this | x;
+	FixedBigInteger a = *this, b = x;
+	int k = (a | b).trailing_zeros();
+	a >>= a.trailing_zeros();
+	do {  // a is odd
+		b >>= b.trailing_zeros();
+		if (a > b) {
+			FixedBigInteger t = a;
+			a = b, b = t;
+		}
+		b -= a;
+	} while (!b.zero());
+	return a << k;
+}
+// Extended Euclid on the remainders of m and this. The cofactors alternate in sign, so only their magnitudes, which
+// stay below m, are kept
+template <int Bits> constexpr FixedBigInteger<Bits> FixedBigInteger<Bits>::modinv(const FixedBigInteger& m) const {
+	FixedBigInteger r0 = m, r1 = *this % m, t0 = 0, t1 = 1;
+	bool neg = false;  // Whether t1 is negative, t0 has the other sign
+	while (!r1.zero()) {
+		std::pair<FixedBigInteger, FixedBigInteger> qr = r0.divmod(r1);
+		FixedBigInteger t = t0 + qr.first * t1;
+		r0 = r1, r1 = qr.second, t0 = t1, t1 = t, neg = !neg;
+	}
+	if (r0 != 1) throw NotInvertibleError();
+	return neg || t0.zero() ? t0 : m - t0;
+}
+
+struct Modulus {  // Arithmetic modulo a fixed p by Barrett reduction, the reciprocal is computed once
+protected:
+	BigInteger p, mu;  // mu = BASE^2k / p rounded down, where p has k limbs
+	int k;
+	BigInteger barrett(const BigInteger&) const;
+public:
+	Modulus(const BigInteger&);
+	const BigInteger& modulus() const {return p;}
+	
+	BigInteger reduce(const BigInteger&) const;
+	BigInteger mul(const BigInteger& a, const BigInteger& b) const {return reduce(a * b);}
+	BigInteger sqr(const BigInteger& a) const {return reduce(a.square());}
+	BigInteger pow(const BigInteger&, const BinaryInteger&) const;
+	BigInteger pow(const BigInteger& a, const BigInteger& e) const {return pow(a, BinaryInteger(e));}
+	BigInteger pow(const BigInteger& a, int64_t e) const {return pow(a, BinaryInteger(e));}
+};
+
+Modulus::Modulus(const BigInteger& x) : p(x.abs()), k(p.digits.size()) {
+	if (p.zero()) throw ZeroDivisionError();
+	BigInteger b = BigInteger(1)._move_l(2 * k), r;
+	std::tie(mu, r) = b.divmod(p);
+	while (r.negative()) mu -= 1, r += p;
+	while (r >= p) mu += 1, r -= p;
+}
+BigInteger Modulus::barrett(const BigInteger& x) const {  // 0 <= x < BASE^2k
+	if ((int) x.digits.size() < k) return x;
+	BigInteger q = (x._move_r(k - 1) * mu)._move_r(k + 1), r = x - q * p;
+	while (r >= p) r -= p;  // At most twice
+	return r;
+}
+BigInteger Modulus::reduce(const BigInteger& x) const {  // In [0, p) for any x
+	int n = x.digits.size();
+	BigInteger r;
+	if (n <= 2 * k) r = barrett(x.abs());
+	else {  // Fold k limbs at a time in from the top, so each step stays below BASE^2k
+		for (int i = (n - 1) / k * k; i >= 0; i -= k) {
+			r = barrett(r._move_l(k) + BigInteger(limb_vector(x.digits.begin() + i, x.digits.begin() + std::min(n, i + k))));
+		}
+	}
+	return x.negative() && !r.zero() ? p - r : r;
+}
+BigInteger Modulus::pow(const BigInteger& a, const BinaryInteger& e) const {  // Sliding windows over the bits of e
+	if (e.negative()) throw NegativeExponentError();
+	int64_t n = e.bit_length();
+	int w = n <= 8 ? 1 : n <= 24 ? 2 : n <= 80 ? 3 : n <= 240 ? 4 : n <= 672 ? 5 : 6;
+	std::vector<BigInteger> odd(1 << (w - 1));  // a^1, a^3, ..., a^(2^w - 1)
+	odd[0] = reduce(a);
+	if (w > 1) {
+		BigInteger a2 = sqr(odd[0]);
+		for (size_t i = 1; i < odd.size(); i++) odd[i] = mul(odd[i - 1], a2);
+	}
+	BigInteger res = reduce(1);
+	bool one = true;  // Skip squaring res while it is still 1
+	for (int64_t i = n - 1; i >= 0; ) {
+		if (!e.test(i)) {
+			if (!one) res = sqr(res);
+			i--;
+			continue;
+		}
+		int64_t j = std::max<int64_t>(i - w + 1, 0);
+		while (!e.test(j)) j++;  // The window e[j, i] starts and ends with a set bit
+		int v = 0;
+		for (int64_t t = i; t >= j; t--) {
+			v = v << 1 | e.test(t);
+			if (!one) res = sqr(res);
+		}
+		res = one ? odd[v >> 1] : mul(res, odd[v >> 1]), one = false, i = j - 1;
+	}
+	return res;
+}
+
+struct Divisor {  // A fixed divisor d with a cached reciprocal BASE^L / d, whose precision L grows on demand
+protected:
+	BigInteger d, inv;  // d = |divisor|, inv = BASE^L / d rounded down
+	bool neg;
+	int k, L;  // d has k limbs, L >= 2k
+	std::pair<BigInteger, BigInteger> divide(const BigInteger&) const;
+	void grow(int);
+public:
+	Divisor(const BigInteger&);
+	BigInteger divisor() const {return neg ? -d : d;}
+	
+	std::pair<BigInteger, BigInteger> divmod(const BigInteger&);
+	BigInteger div(const BigInteger& a) {return divmod(a).first;}
+	BigInteger mod(const BigInteger& a) {return divmod(a).second;}
+};
+
+Divisor::Divisor(const BigInteger& x) : d(x.abs()), neg(x.negative()), k(d.digits.size()), L(2 * k) {
+	if (d.zero()) throw ZeroDivisionError();
+	BigInteger r;
+	std::tie(inv, r) = BigInteger(1)._move_l(L).divmod(d);
+	while (r.negative()) inv -= 1, r += d;
+	while (r >= d) inv += 1, r -= d;
+}
+std::pair<BigInteger, BigInteger> Divisor::divide(const BigInteger& a) const {  // 0 <= a < BASE^L
+	int n = a.digits.size();
+	if (n < k) return std::make_pair(BigInteger(), a);
+	if (k == 1) {
+		BigInteger q = a / d.digits[0];
+		return std::make_pair(q, a - q * d);
+	}
+	// With mu = BASE^n / d, the estimate is at most 2 below the quotient
+	BigInteger q = (a._move_r(k - 1) * inv._move_r(L - n))._move_r(n - k + 1), r = a - q * d;
+	while (r >= d) q += 1, r -= d;
+	return std::make_pair(q, r);
+}
+void Divisor::grow(int n) {
+	while (L < n) {  // BASE^2L / d = inv * BASE^L + (r * BASE^L) / d, the last one divided in pieces of L - k limbs
+		BigInteger q = inv, r = BigInteger(1)._move_l(L) - inv * d;
+		for (int left = L, s; left > 0; left -= s) {
+			s = std::min(left, L - k);
+			auto qr = divide(r._move_l(s));
+			q = q._move_l(s) + qr.first, r = qr.second;
+		}
+		inv = q, L <<= 1;
+	}
+}
+std::pair<BigInteger, BigInteger> Divisor::divmod(const BigInteger& a) {  // Truncating, as BigInteger::divmod
+	grow(a.digits.size());
+	auto qr = divide(a.abs());
+	if (!qr.first.zero()) qr.first.flag = a.flag != neg;
+	if (!qr.second.zero()) qr.second.flag = a.flag;
+	return qr;
+}
+
+// A fixed factor b, whose transforms are computed once per length and reused by every product. Below NTT_LIMIT the
+// other factor is cut in two halves that share one FFT, so a product takes two transforms of n + 2m digits in base
+// 10^4 instead of 2(n + m), and from NTT_LIMIT on, the NTT of b is skipped
+struct Multiplicand {
+protected:
+	BigInteger b;
+	std::map<int, std::vector<double>> fft;  // The transforms of |b| by length, real parts then imaginary parts
+	std::map<int, std::vector<uint64_t>> ntt;  // The same modulo both primes
+	const double* fft_transform(int);
+	const uint64_t* ntt_transform(int);
+	friend struct Accumulator;
+public:
+	Multiplicand(const BigInteger& x) : b(x) {}
+	const BigInteger& value() const {return b;}
+	
+	BigInteger mul(const BigInteger&);
+};
+
+// A sum of products by Multiplicands, added up in the transform domain and inverted once when the value is needed.
+// Each product of about balanced factors of at least FFT_LIMIT limbs costs one forward transform
+struct Accumulator {
+protected:
+	BigInteger sum;  // The part already out of the transform domain
+	int lim = 0, k = 0;  // The transform length and, for the FFT, where the other factors are cut in two halves
+	bool ntt = false;
+	int64_t load = 0;  // The total length of the FFT products, bounded so that their rounding stays exact
+	std::vector<double> facc[2], ftmp;  // The transforms of the sums of the positive and of the negative products
+	std::vector<uint64_t> nacc[2], ntmp;
+	void flush();
+public:
+	void add(const BigInteger& a, Multiplicand& b);
+	void add(const BigInteger& a, const BigInteger& b) {sum += a * b;}
+	BigInteger value() {return flush(), sum;}
+};
+
+const double* Multiplicand::fft_transform(int lim) {
+	std::vector<double>& t = fft[lim];
+	if (t.empty()) t.assign(2 * lim, 0.0), __FFT::split(b.digits.data(), b.digits.size(), t.data()), __FFT::dft(t.data(), t.data() + lim, lim);
+	return t.data();
+}
+#ifdef __SIZEOF_INT128__
+const uint64_t* Multiplicand::ntt_transform(int lim) {
+	std::vector<uint64_t>& t = ntt[lim];
+	if (t.empty()) t.resize(2 * lim), __NTT::transform(b.digits.data(), b.digits.size(), lim, t.data());
+	return t.data();
+}
+#endif  // __SIZEOF_INT128__
+BigInteger Multiplicand::mul(const BigInteger& a) {  // a * b
+	int n = a.digits.size(), m = b.digits.size(), lim = 1;
+	if (std::min(n, m) < FFT_LIMIT && !(n >= 4 * m && m >= UNBALANCED_FFT_LIMIT)) return a * b;
+	if (4 * n < m) return a * b;  // Then the blocks of b go through the transform of a
+	BigInteger c;
+	if ((n >= 4 * m ? 4 * m : n + m) >= NTT_LIMIT) {
+#ifdef __SIZEOF_INT128__
+		limb_vector res(n + m);
+		__NTT::multiply(a.digits.data(), n, b.digits.data(), m, res.data(), ntt_transform(__NTT::length(n, m)));
+		c = BigInteger(std::move(res));
+#else
+		return a * b;
+#endif  // __SIZEOF_INT128__
+	} else {
+		while (lim < (n >= 4 * m ? 8 * m : 2 * ((n + 1) / 2 + m))) lim <<= 1;
+		c = BigInteger::fft_mul_unbalanced(a, b, lim, fft_transform(lim));
+	}
+	c.flag = c.zero() || a.flag == b.flag;
+	return c;
+}
+
+void Accumulator::add(const BigInteger& a, Multiplicand& x) {
+	const BigInteger& b = x.b;
+	int n = a.digits.size(), m = b.digits.size(), h = (n + 1) >> 1, need = 1;
+	if (std::min(n, m) < FFT_LIMIT || n > 4 * m || m > 4 * n || a.zero() || b.zero()) return void(sum += x.mul(a));
+	bool big = n + m >= NTT_LIMIT;
+#ifndef __SIZEOF_INT128__
+	if (big) return void(sum += x.mul(a));
+#endif  // __SIZEOF_INT128__
+	while (need < (big ? n + m : 2 * (h + m))) need <<= 1;
+	if (lim != 0 && (big != ntt || (big ? need > lim : h > k || k + m > lim >> 1 || load + std::min(k, m) > NTT_LIMIT / 2))) flush();
+	if (lim != 0 && need * 2 <= lim) return void(sum += x.mul(a));  // Not padded to more than twice its length
+	if (lim == 0) lim = need, k = (lim >> 1) - m, ntt = big, load = 0;
+	int s = a.flag != b.flag;
+	if (ntt) {
+#ifdef __SIZEOF_INT128__
+		const uint64_t* y = x.ntt_transform(lim);
+		std::vector<uint64_t>& acc = nacc[s];
+		if (acc.empty()) acc.assign(2 * lim, 0);
+		ntmp.resize(2 * lim), __NTT::transform(a.digits.data(), n, lim, ntmp.data());
+		for (int t = 0; t < 2; t++) {
+			const __NTT::field& f = __NTT::P[t];
+			for (int j = t * lim; j < (t + 1) * lim; j++) acc[j] = f.add(acc[j], f.mul(ntmp[j], y[j]));
+		}
+#endif  // __SIZEOF_INT128__
+	} else {
+		const double* y = x.fft_transform(lim);
+		std::vector<double>& acc = facc[s];
+		if (acc.empty()) acc.assign(2 * lim, 0.0);
+		ftmp.assign(2 * lim, 0.0), load += std::min(k, m);
+		__FFT::split(a.digits.data(), std::min(n, k), ftmp.data());  // The low half in the real part, the high half in the imaginary part
+		if (n > k) __FFT::split(a.digits.data() + k, n - k, ftmp.data() + lim);
+		__FFT::dft(ftmp.data(), ftmp.data() + lim, lim);
+		__FFT::mul_add(acc.data(), acc.data() + lim, ftmp.data(), ftmp.data() + lim, y, y + lim, lim);
+	}
 }
-BigInteger BigInteger::operator| (const BigInteger& x) const {
-	return __helper(*this, x, [](bool a, bool b) -> bool {return a | b;});
+void Accumulator::flush() {
+	for (int s = 0; s < 2; s++) {
+		limb_vector res(lim + 4);
+		if (!facc[s].empty()) {
+			double *re = facc[s].data(), *im = re + lim;
+			int sz = lim >> 1;
+			__FFT::idft(re, im, lim), __FFT::scale(re, lim, 1.0 / lim), __FFT::scale(im, lim, 1.0 / lim);
+			__FFT::join(re, sz, res.data());
+			BigInteger hi;
+			hi.digits.resize(sz + 4), __FFT::join(im, sz, hi.digits.data()), hi.trim();
+			BigInteger c = BigInteger(std::move(res)) + hi._move_l(k);
+			if (s) sum -= c;
+			else sum += c;
+			facc[s].clear();
+		}
+#ifdef __SIZEOF_INT128__
+		if (!nacc[s].empty()) {  // Each value is below 2^71 per product, far from p0 * p1 > 2^123
+			uint64_t *x = nacc[s].data(), *y = x + lim;
+			__NTT::dit(0, x, lim), __NTT::dit(1, y, lim), __NTT::crt(x, y, lim, lim, res.data());
+			if (s) sum -= BigInteger(std::move(res));
+			else sum += BigInteger(std::move(res));
+			nacc[s].clear();
+		}
+#endif  // __SIZEOF_INT128__
+	}
+	lim = 0;
 }
-BigInteger BigInteger::operator^ (const BigInteger& x) const {
-	return __helper(*this, x, [](bool a, bool b) -> bool {return a ^ b;});
+
+// Binary format, all words little-endian: the header ("BIGI" and the version 1 as uint32), the count (uint64), the byte
+// offset of each value from the start (uint64), then each value as (limbs << 1 | negative) (uint64) followed by its limbs
+// (int64 in base 10^8, the top one nonzero unless the value is 0). Every value starts at a multiple of 8 bytes, so the
+// limbs of a mapped file can be used in place
+void BigInteger::save(std::ostream& out) const {save(out, this, 1);}
+void BigInteger::save(std::ostream& out, const BigInteger* v, size_t count) {
+	char buf[4096];
+	int len = 0;
+	auto put = [&](uint64_t x) {
+		if (len == (int) sizeof(buf)) out.write(buf, len), len = 0;
+		__IO::store64(buf + len, x), len += 8;
+	};
+	put(__IO::HEADER), put(count);
+	uint64_t off = 16 + 8 * count;
+	for (size_t i = 0; i < count; i++) put(off), off += 8 * (v[i].digits.size() + 1);
+	for (size_t i = 0; i < count; i++) {
+		int n = v[i].digits.size();
+		put((uint64_t) n << 1 | v[i].negative());
+		for (int j = 0, k; j < n; j += k) {  // As many limbs as fit at once
+			if (len == (int) sizeof(buf)) out.write(buf, len), len = 0;
+			k = std::min(n - j, (int) (sizeof(buf) - len) / 8);
+			for (int t = 0; t < k; t++) __IO::store64(buf + len + 8 * t, v[i].digits[j + t]);
+			len += 8 * k;
+		}
+	}
+	out.write(buf, len);
 }
-BigInteger& BigInteger::operator&= (const BigInteger& x) {
-	return *this = __helper(*this, x, [](bool a, bool b) -> bool {return a & b;});
+BigInteger BigInteger::load(std::istream& in) {
+	std::vector<BigInteger> v = load_all(in);
+	if (v.size() != 1) throw InvalidFormatError();
+	return std::move(v[0]);
 }
-BigInteger& BigInteger::operator|= (const BigInteger& x) {
-	return *this = __helper(*this, x, [](bool a, bool b) -> bool {return a | b;});
+std::vector<BigInteger> BigInteger::load_all(std::istream& in) {  // Every limb is checked, unlike in ArchiveView
+	char buf[8];
+	auto get = [&]() {
+		if (!in.read(buf, 8)) throw InvalidFormatError();
+		return __IO::load64(buf);
+	};
+	if (get() != __IO::HEADER) throw InvalidFormatError();
+	uint64_t count = get(), pos = 16;
+	std::vector<uint64_t> off;
+	for (uint64_t i = 0; i < count; i++) off.emplace_back(get()), pos += 8;
+	std::vector<BigInteger> res;
+	res.reserve(count);
+	for (uint64_t i = 0; i < count; i++) {
+		if (off[i] < pos || off[i] % 8 != 0) throw InvalidFormatError();
+		for (; pos < off[i]; pos += 8) get();
+		uint64_t head = get(), n = head >> 1;
+		if (n == 0 || n > INT_MAX) throw InvalidFormatError();
+		BigInteger x;
+		for (uint64_t j = 0; j < n; j += 1 << 16) {  // In blocks, so that a bad length fails before it is allocated
+			int k = std::min<uint64_t>(n - j, 1 << 16);
+			x.digits.resize(j + k);
+			char* p = reinterpret_cast<char*>(x.digits.data() + j);
+			if (!in.read(p, 8 * k)) throw InvalidFormatError();
+			for (int t = 0; t < k; t++) {
+				digit_t d = __IO::load64(p + 8 * t);
+				if (d < 0 || d >= BASE) throw InvalidFormatError();
+				x.digits[j + t] = d;
+			}
+		}
+		x.flag = !(head & 1), pos += 8 * (n + 1);
+		if ((n > 1 && x.digits.back() == 0) || (x.zero() && x.negative())) throw InvalidFormatError();
+		res.emplace_back(std::move(x));
+	}
+	return res;
 }
-BigInteger& BigInteger::operator^= (const BigInteger& x) {
-	return *this = __helper(*this, x, [](bool a, bool b) -> bool {return a ^ b;});
+
+// A read-only value on limbs held elsewhere, such as a record of a mapped archive or a BigInteger that outlives the view
+struct BigIntegerView {
+protected:
+	const digit_t* d;
+	int n;
+	bool neg;
+public:
+	constexpr BigIntegerView(const digit_t* d, int n, bool neg) : d(d), n(n), neg(neg) {}
+	BigIntegerView(const BigInteger& x) : d(x.digits.data()), n(x.digits.size()), neg(x.negative()) {}
+	constexpr const digit_t* limbs() const {return d;}
+	constexpr int size() const {return n;}
+	constexpr bool negative() const {return neg;}
+	constexpr bool zero() const {return n == 1 && d[0] == 0;}
+	BigInteger to_bigint() const;
+	
+	int compare(const BigIntegerView&) const;
+	bool operator== (const BigIntegerView& x) const {return compare(x) == 0;}
+	bool operator!= (const BigIntegerView& x) const {return compare(x) != 0;}
+	bool operator< (const BigIntegerView& x) const {return compare(x) < 0;}
+	bool operator<= (const BigIntegerView& x) const {return compare(x) <= 0;}
+	bool operator> (const BigIntegerView& x) const {return compare(x) > 0;}
+	bool operator>= (const BigIntegerView& x) const {return compare(x) >= 0;}
+	
+	size_t to_chars_length() const {return __IO::chars_length(d, n, neg);}
+	friend std::to_chars_result to_chars(char* first, char* last, const BigIntegerView& x) {
+		return __IO::to_chars(first, last, x.d, x.n, x.neg);
+	}
+	friend std::ostream& operator<< (std::ostream& out, const BigIntegerView& x) {
+		__IO::format(x.d, x.n, x.neg, [&](const char* p, int k) {out.write(p, k);});
+		return out;
+	}
+};
+
+// The values of a binary archive in place, such as a mapped file, which must be 8-byte aligned and outlive the view.
+// Opening and indexing take O(1) and check the header and the bounds of the record, but not the limbs
+struct ArchiveView {
+protected:
+	const char* p;
+	size_t bytes, count;
+public:
+	ArchiveView(const void*, size_t);
+	size_t size() const {return count;}
+	BigIntegerView operator[] (size_t) const;
+};
+
+// A decimal constant whose limbs are computed at compile time, so that tables of them need no constructor at startup.
+// N is the capacity in limbs, which the deduction guide takes from the length of a string literal
+template <int N> struct BigIntegerConstant {
+protected:
+	digit_t d[N];
+	int n;
+	bool neg;
+public:
+	constexpr BigIntegerConstant(const char*);
+	constexpr const digit_t* limbs() const {return d;}
+	constexpr int size() const {return n;}
+	constexpr bool negative() const {return neg;}
+	constexpr BigIntegerView view() const {return BigIntegerView(d, n, neg);}
+	constexpr operator BigIntegerView() const {return view();}
+	BigInteger to_bigint() const {return view().to_bigint();}
+	operator BigInteger() const {return to_bigint();}
+	friend std::ostream& operator<< (std::ostream& out, const BigIntegerConstant& x) {return out << x.view();}
+};
+template <size_t M> BigIntegerConstant(const char (&)[M]) -> BigIntegerConstant<M / 8 + 1>;
+
+// Leading '-' signs, then decimal digits which may be grouped by ', as in a literal
+template <int N> constexpr BigIntegerConstant<N>::BigIntegerConstant(const char* s) : d(), n(0), neg(false) {
+	for (; *s == '-'; s++) neg ^= 1;
+	const char* end = s;
+	while (*end) end++;
+	digit_t pw = 1;
+	for (int k = 0; end != s; ) {  // The k-th digit from the right goes to limb k / 8
+		char c = *--end;
+		if (c == '\'') continue;
+		if (c < '0' || c > '9') throw std::invalid_argument("Invalid decimal digit");
+		if (k >> 3 >= N) throw std::length_error("Too many digits for BigIntegerConstant");
+		d[k >> 3] += (c - '0') * pw, pw = ++k & 7 ? pw * 10 : 1;
+		if (c != '0') n = (k + 7) >> 3;
+	}
+	if (n == 0) n = 1, neg = false;
+}
+// A decimal literal such as 12345678901234567890_bi. Its limbs are computed at compile time and only copied at run time
+template <char... C> BigInteger operator""_bi() {
+	static constexpr char s[] = {C..., '\0'};
+	static constexpr BigIntegerConstant<sizeof...(C) / 8 + 1> k(s);
+	return k.to_bigint();
 }
 
-BigInteger factorial(int32_t n) {
-	BigInteger res = 1;
-	for (int32_t i = 2; i <= n; i++) res *= i;
+BigInteger BigIntegerView::to_bigint() const {
+	BigInteger res(limb_vector(d, d + n));
+	res.flag = !neg || res.zero();
 	return res;
 }
+int BigIntegerView::compare(const BigIntegerView& x) const {
+	if (neg != x.neg) return neg ? -1 : 1;
+	int c = __MUL::compare(d, n, x.d, x.n);
+	return neg ? -c : c;
+}
+ArchiveView::ArchiveView(const void* data, size_t size) : p(static_cast<const char*>(data)), bytes(size), count(0) {
+	if (!__IO::HOST_LITTLE_ENDIAN || reinterpret_cast<uintptr_t>(data) % 8 != 0) throw InvalidFormatError();
+	if (size < 16 || __IO::load64(p) != __IO::HEADER || __IO::load64(p + 8) > (size - 16) / 8) throw InvalidFormatError();
+	count = __IO::load64(p + 8);
+}
+BigIntegerView ArchiveView::operator[] (size_t i) const {
+	if (i >= count) throw std::out_of_range("Archive index out of range");
+	uint64_t off = __IO::load64(p + 16 + 8 * i);
+	if (off % 8 != 0 || off > bytes - 8) throw InvalidFormatError();
+	uint64_t head = __IO::load64(p + off), n = head >> 1;
+	if (n == 0 || n > INT_MAX || n > (bytes - off) / 8 - 1) throw InvalidFormatError();
+	return BigIntegerView(reinterpret_cast<const digit_t*>(p + off + 8), n, head & 1);
+}
+
+BigInteger BigInteger::pow(int64_t b, const BigInteger& p) const {return Modulus(p).pow(*this, b);}
+BigInteger BigInteger::pow(const BigInteger& b, const BigInteger& p) const {return Modulus(p).pow(*this, b);}
+
+BigInteger product(int64_t a, int64_t b) {  // a (a + 1) ... b by binary splitting, 1 when a > b
+	if (a > b) return 1;
+	if (a <= 0 && b >= 0) return 0;
+	if (b < 0) return (b - a) & 1 ? product(-b, -a) : -product(-b, -a);
+	if (b - a < 16) {
+		BigInteger res = 1;
+		int64_t cur = 1;
+		for (int64_t i = a; i <= b; i++) {
+			if (i >= BASE) res *= BigInteger(i);
+			else if (cur > BASE * BASE / i) res *= BigInteger(cur), cur = i;
+			else cur *= i;
+		}
+		return res *= BigInteger(cur);
+	}
+	int64_t mid = a + ((b - a) >> 1);
+	return product(a, mid) * product(mid + 1, b);
+}
+namespace __COMB {  // Products of many small factors, combined in balanced trees so that large products reach FFT and NTT
+	constexpr int SWING_LIMIT = 32;  // Factorials below this are plain products
+	constexpr int64_t SIEVE_LIMIT = 1LL << 27;  // The largest n for which binomial(n, k) factors itself by primes
+	
+	inline std::vector<int32_t> primes(int32_t n) {  // The primes up to n by a sieve on odd numbers
+		std::vector<int32_t> res;
+		if (n >= 2) res.emplace_back(2);
+		std::vector<bool> comp((n + 1) >> 1);
+		for (int64_t i = 3; i <= n; i += 2) {
+			if (comp[i >> 1]) continue;
+			res.emplace_back(i);
+			for (int64_t j = i * i; j <= n; j += 2 * i) comp[j >> 1] = true;
+		}
+		return res;
+	}
+	inline BigInteger tree(std::vector<BigInteger>& v, size_t l, size_t r) {  // v[l] * ... * v[r - 1], consuming v
+		if (r - l == 1) return std::move(v[l]);
+		size_t mid = (l + r) >> 1;
+		return tree(v, l, mid) * tree(v, mid, r);
+	}
+	inline void push(std::vector<BigInteger>& v, int64_t& cur, int64_t x) {  // Pack small factors two limbs at a time
+		if (cur > BASE * BASE / x) v.emplace_back(cur), cur = 1;
+		cur *= x;
+	}
+	inline BigInteger swing(int32_t n, const std::vector<int32_t>& p) {  // n! / (n/2)!^2, where p has the primes up to n
+		std::vector<BigInteger> v;
+		int64_t cur = 1;
+		for (int32_t x : p) {
+			if (x > n) break;
+			int64_t f = 1;
+			for (int32_t q = n / x; q > 0; q /= x) if (q & 1) f *= x;
+			if (f > 1) push(v, cur, f);
+		}
+		v.emplace_back(cur);
+		return tree(v, 0, v.size());
+	}
+	inline BigInteger factorial(int32_t n, const std::vector<int32_t>& p) {
+		if (n < SWING_LIMIT) return product(2, n);
+		return factorial(n >> 1, p).square() * swing(n, p);
+	}
+}
+
+BigInteger product(std::vector<BigInteger> v) {  // Multiplied in a balanced tree
+	if (v.empty()) return 1;
+	return __COMB::tree(v, 0, v.size());
+}
+BigInteger factorial(int32_t n) {  // By the prime swing: n! = (n/2)!^2 * swing(n)
+	if (n < __COMB::SWING_LIMIT) return product(2, n);
+	return __COMB::factorial(n, __COMB::primes(n));
+}
+BigInteger rising_factorial(const BigInteger& x, int64_t n) {  // x (x + 1) ... (x + n - 1)
+	if (n <= 0) return 1;
+	if (x.abs() < BigInteger(LLONG_MAX / 2) && n < LLONG_MAX / 2) {
+		int64_t a = x.to_int64();
+		return product(a, a + n - 1);
+	}
+	std::vector<BigInteger> v(n);
+	for (int64_t i = 0; i < n; i++) v[i] = x + BigInteger(i);
+	return product(std::move(v));
+}
+BigInteger binomial(int64_t n, int64_t k) {
+	if (k < 0) return 0;
+	if (n < 0) return k & 1 ? -binomial(k - n - 1, k) : binomial(k - n - 1, k);
+	if (k > n) return 0;
+	k = std::min(k, n - k);
+	if (k < __COMB::SWING_LIMIT || n > __COMB::SIEVE_LIMIT || k < n / 64) return product(n - k + 1, n).divexact(factorial(k));
+	std::vector<BigInteger> v;  // The exponent of p is the number of borrows when subtracting k from n in base p (Kummer)
+	int64_t cur = 1;
+	for (int32_t p : __COMB::primes(n)) {
+		int64_t f = 1;
+		for (int64_t a = n, b = k, borrow = 0; a > 0; a /= p, b /= p) {
+			borrow = a % p < b % p + borrow;
+			if (borrow) f *= p;
+		}
+		if (f > 1) __COMB::push(v, cur, f);
+	}
+	v.emplace_back(cur);
+	return __COMB::tree(v, 0, v.size());
+}
 BigInteger rand_bigint(int32_t n) {
 	std::mt19937 e(std::chrono::system_clock::now().time_since_epoch().count());
 	std::uniform_int_distribution<unsigned> u0(0, 9), u1(1, 9);
@@ -843,4 +3272,11 @@ BigInteger rand_bigint(int32_t n) {
 	for (int32_t i = 2; i <= n; i++) s += u1(e) ^ 48;
 	return s;
 }
+// Split products (and so division and roots) of total length at least limit limbs across threads in total, the caller
+// included. threads <= 1 turns it off, which is the default. Must not be called while another thread computes
+void set_parallel(int threads, int64_t limit = PARALLEL_LIMIT) {
+	__POOL::active.reset();
+	__POOL::limit = limit;
+	if (threads > 1) __POOL::active.reset(new __POOL::pool(threads - 1));
+}
 #endif  // BIGINTEGER_H